@@ -0,0 +1,91 @@
+#include "ThreadPool.h"
+
+Concurrency::ThreadPool::ThreadPool(int threads):
+    _count(0), 
+    _nextIndex(0), 
+    _batch(0), 
+    _busyWorkers(0), 
+    _stopping(false) {
+    for (int thread = 1; thread < threads; thread++) {
+        this->_workers.emplace_back(&Concurrency::ThreadPool::_work, this, thread);
+    }
+}
+
+Concurrency::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stopping = true;
+    }
+    this->_batchStarted.notify_all();
+    for (auto& worker : this->_workers) {
+        worker.join();
+    }
+}
+
+int Concurrency::ThreadPool::threads()
+{
+    return (int) this->_workers.size() + 1;
+}
+
+void Concurrency::ThreadPool::forEach(int count, std::function<void(int index, int thread)> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_job = job;
+        this->_count = count;
+        this->_nextIndex = 0;
+        this->_exception = nullptr;
+        this->_busyWorkers = (int) this->_workers.size();
+        this->_batch = this->_batch + 1;
+    }
+    this->_batchStarted.notify_all();
+
+    // The calling thread takes part in the batch as the first thread.
+    this->_runJobs(0);
+
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_batchFinished.wait(lock, [this]() { return this->_busyWorkers == 0; });
+    this->_job = nullptr;
+    if (this->_exception != nullptr) {
+        std::rethrow_exception(this->_exception);
+    }
+}
+
+void Concurrency::ThreadPool::_work(int thread)
+{
+    int batch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_batchStarted.wait(lock, [this, batch]() { return this->_stopping || this->_batch != batch; });
+            if (this->_stopping) {
+                return;
+            }
+            batch = this->_batch;
+        }
+        this->_runJobs(thread);
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_busyWorkers = this->_busyWorkers - 1;
+        }
+        this->_batchFinished.notify_all();
+    }
+}
+
+void Concurrency::ThreadPool::_runJobs(int thread)
+{
+    while (true) {
+        int index = this->_nextIndex.fetch_add(1);
+        if (index >= this->_count) {
+            return;
+        }
+        try {
+            this->_job(index, thread);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            if (this->_exception == nullptr) {
+                this->_exception = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef CONCURRENCY_THREAD_POOL_HH
+#define CONCURRENCY_THREAD_POOL_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+    /**
+     * A fixed set of worker threads that run batches of jobs. The workers are started 
+     * once and wait between batches, so running a batch costs no thread creation.
+     */
+    class ThreadPool {
+        public:
+            /**
+             * Starts a pool where batches run on the given amount of threads, 
+             * the calling thread included.
+             */
+            ThreadPool(int threads);
+            ~ThreadPool();
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+            int threads();
+            /**
+             * Calls the job with every index from 0 up to the count, together with the index 
+             * of the thread running it, and returns when all calls have returned. The indices 
+             * are handed out one at a time, so threads that finish early take on more of them. 
+             * If any call throws, the first exception is rethrown once all threads are done.
+             */
+            void forEach(int count, std::function<void(int index, int thread)> job);
+        private:
+            std::vector<std::thread> _workers;
+            std::mutex _mutex;
+            std::condition_variable _batchStarted;
+            std::condition_variable _batchFinished;
+            std::function<void(int index, int thread)> _job;
+            int _count;
+            std::atomic<int> _nextIndex;
+            int _batch;
+            int _busyWorkers;
+            bool _stopping;
+            std::exception_ptr _exception;
+            void _work(int thread);
+            void _runJobs(int thread);
+    };
+};
+
+#endif
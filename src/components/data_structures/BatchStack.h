@@ -1,6 +1,7 @@
 #ifndef DATA_STRUCTURES_BATCH_STACK_HH
 #define DATA_STRUCTURES_BATCH_STACK_HH
 
+#include <algorithm>
 #include <stack>
 #include <vector>
 
@@ -0,0 +1,168 @@
+#ifndef DATA_STRUCTURES_SCOPED_SYMBOL_TABLE_HH
+#define DATA_STRUCTURES_SCOPED_SYMBOL_TABLE_HH
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace DataStructures {
+    /**
+     * A symbol table of nested scopes, keyed by interned names such as the ids of
+     * Parsing::Names. Searching for a name finds its binding in the innermost scope
+     * that has one. By default the table starts with a single scope.
+     *
+     * One open-addressing hash table maps each name to the innermost of its bindings,
+     * and each binding remembers the binding it shadows. Bindings are kept on a stack
+     * in the order they were made, which doubles as the undo log of the scopes: leaving
+     * a scope pops the bindings made in it and restores the ones they shadowed. Looking
+     * up a name therefore costs the same however deeply scopes are nested, and entering
+     * and leaving a scope costs only the bindings made in it.
+     */
+    template <class T>
+    class ScopedSymbolTable {
+        public:
+            ScopedSymbolTable();
+            /**
+             * Get the value bound to the given name. The reference is valid until the
+             * next binding is made.
+             */
+            T& at(int name);
+            /**
+             * Whether the given name is bound in any scope.
+             */
+            bool contains(int name);
+            /**
+             * Whether the given name is bound in the innermost scope.
+             */
+            bool containsInFront(int name);
+            /**
+             * Bind the given value to the given name in the innermost scope, unless the
+             * name is bound there already.
+             */
+            void insert(int name, T value);
+            /**
+             * Enter a new innermost scope.
+             */
+            void pushFront();
+            /**
+             * Leave the innermost scope, forgetting the bindings made in it. Will not
+             * leave the outermost scope, since the table always has at least one.
+             */
+            void popFront();
+        private:
+            static constexpr int none = -1;
+            struct DSlot {
+                int name {none};
+                // The index of the innermost binding of the name, or none if it is unbound.
+                int binding {none};
+            };
+            struct DBinding {
+                int name;
+                T value;
+                // The index of the binding of the same name that this binding shadows.
+                int shadowed;
+            };
+            DSlot& _slot(int name);
+            void _grow();
+            std::vector<DSlot> _slots;
+            int _names = 0;
+            std::vector<DBinding> _bindings;
+            // The index of the first binding of each scope.
+            std::vector<int> _scopes;
+    };
+
+    template<class T>
+    inline ScopedSymbolTable<T>::ScopedSymbolTable():
+        _slots(16)
+    {
+        this->pushFront();
+    }
+
+    template<class T>
+    inline T& ScopedSymbolTable<T>::at(int name)
+    {
+        auto binding = this->_slot(name).binding;
+        if (binding == none) {
+            throw std::runtime_error("No value for the name " + std::to_string(name) + " in ScopedSymbolTable.");
+        }
+        return this->_bindings[binding].value;
+    }
+
+    template<class T>
+    inline bool ScopedSymbolTable<T>::contains(int name)
+    {
+        return this->_slot(name).binding != none;
+    }
+
+    template<class T>
+    inline bool ScopedSymbolTable<T>::containsInFront(int name)
+    {
+        return this->_slot(name).binding >= this->_scopes.back();
+    }
+
+    template<class T>
+    inline void ScopedSymbolTable<T>::insert(int name, T value)
+    {
+        auto& slot = this->_slot(name);
+        if (slot.binding >= this->_scopes.back()) {
+            return;
+        }
+        if (slot.name == none) {
+            slot.name = name;
+            this->_names = this->_names + 1;
+        }
+        this->_bindings.push_back(DBinding{name, value, slot.binding});
+        slot.binding = (int) this->_bindings.size() - 1;
+        // Keep at most half of the slots in use so that probe sequences stay short.
+        if (this->_names * 2 > (int) this->_slots.size()) {
+            this->_grow();
+        }
+    }
+
+    template<class T>
+    inline void ScopedSymbolTable<T>::pushFront()
+    {
+        this->_scopes.push_back((int) this->_bindings.size());
+    }
+
+    template<class T>
+    inline void ScopedSymbolTable<T>::popFront()
+    {
+        if (this->_scopes.size() > 1) {
+            while ((int) this->_bindings.size() > this->_scopes.back()) {
+                auto& binding = this->_bindings.back();
+                this->_slot(binding.name).binding = binding.shadowed;
+                this->_bindings.pop_back();
+            }
+            this->_scopes.pop_back();
+        }
+    }
+
+    template<class T>
+    inline typename ScopedSymbolTable<T>::DSlot& ScopedSymbolTable<T>::_slot(int name)
+    {
+        // Linear probing from a multiplicative hash of the name. Names whose bindings
+        // have all been forgotten keep their slots, so no slot is ever removed.
+        std::size_t mask = this->_slots.size() - 1;
+        std::size_t index = ((std::uint32_t) name * 0x9E3779B9u) & mask;
+        while (this->_slots[index].name != name && this->_slots[index].name != none) {
+            index = (index + 1) & mask;
+        }
+        return this->_slots[index];
+    }
+
+    template<class T>
+    inline void ScopedSymbolTable<T>::_grow()
+    {
+        auto slots = std::move(this->_slots);
+        this->_slots = std::vector<DSlot>(slots.size() * 2);
+        for (auto& slot : slots) {
+            if (slot.name != none) {
+                this->_slot(slot.name) = slot;
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef DATA_STRUCTURES_TREE_FOLD_HH
+#define DATA_STRUCTURES_TREE_FOLD_HH
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace DataStructures {
+    /**
+     * Performs a fold over the tree rooted at the given node (as fold is understood in
+     * functional programming). Nodes are anything with a children() method returning
+     * an indexable range of nodes, such as Expression*.
+     *
+     * The folding functions are given as template parameters, so that they are called
+     * directly and can be inlined, and any of them can be left out with nullptr:
+     *  - preFolder(acc, node) is applied to a node before its children.
+     *  - inFolder(acc, node, childIndex) is applied to a node after each of its children.
+     *  - postFolder(acc, node) is applied to a node after its children, i.e. in post-order.
+     *
+     * The tree is walked with a stack of its own instead of recursion, so the depth of
+     * the tree is only limited by memory.
+     */
+    template <auto postFolder, auto preFolder = nullptr, auto inFolder = nullptr, class TAccumulator, class TNode>
+    inline TAccumulator foldTree(TNode root, TAccumulator acc)
+    {
+        // A node being folded and the index of its next child to fold.
+        struct DFrame {
+            TNode node;
+            std::size_t nextChild;
+        };
+        auto pre = [](TAccumulator acc, TNode node) {
+            if constexpr (std::is_null_pointer_v<decltype(preFolder)>) {
+                return acc;
+            } else {
+                return preFolder(acc, node);
+            }
+        };
+
+        auto stack = std::vector<DFrame>{};
+        stack.reserve(64);
+        acc = pre(acc, root);
+        stack.push_back(DFrame{root, 0});
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            if (frame.nextChild < frame.node->children().size()) {
+                // Descend into the next child.
+                TNode child = frame.node->children()[frame.nextChild];
+                frame.nextChild = frame.nextChild + 1;
+                acc = pre(acc, child);
+                stack.push_back(DFrame{child, 0});
+            } else {
+                // All children are folded, so the node itself can be folded.
+                TNode node = frame.node;
+                stack.pop_back();
+                if constexpr (!std::is_null_pointer_v<decltype(postFolder)>) {
+                    acc = postFolder(acc, node);
+                }
+                // Perform the in-order folding function for the parent node.
+                if constexpr (!std::is_null_pointer_v<decltype(inFolder)>) {
+                    if (!stack.empty()) {
+                        auto& parent = stack.back();
+                        acc = inFolder(acc, parent.node, (int) parent.nextChild - 1);
+                    }
+                }
+            }
+        }
+        return acc;
+    }
+};
+
+#endif
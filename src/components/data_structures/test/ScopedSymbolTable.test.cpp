@@ -0,0 +1,107 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../../../libraries/doctest.h"
+#include "../ScopedSymbolTable.h"
+#include <string>
+
+TEST_CASE("Inner scopes shadow the bindings of outer scopes") {
+    auto table = DataStructures::ScopedSymbolTable<std::string>{};
+    table.insert(1, "outer x");
+    table.insert(2, "outer y");
+    table.pushFront();
+    table.insert(1, "inner x");
+
+    REQUIRE(table.at(1) == "inner x");
+    REQUIRE(table.at(2) == "outer y");
+    table.pushFront();
+    table.insert(1, "innermost x");
+    REQUIRE(table.at(1) == "innermost x");
+
+    // A name bound in the innermost scope keeps its first binding there.
+    table.insert(1, "another x");
+    REQUIRE(table.at(1) == "innermost x");
+}
+
+TEST_CASE("Leaving a scope restores the bindings it shadowed") {
+    auto table = DataStructures::ScopedSymbolTable<int>{};
+    table.insert(1, 10);
+    table.pushFront();
+    table.insert(1, 11);
+    table.insert(2, 21);
+    table.pushFront();
+    table.insert(1, 12);
+
+    table.popFront();
+    REQUIRE(table.at(1) == 11);
+    REQUIRE(table.at(2) == 21);
+    table.popFront();
+    REQUIRE(table.at(1) == 10);
+    REQUIRE(!table.contains(2));
+    REQUIRE_THROWS(table.at(2));
+
+    // The outermost scope is never left.
+    table.popFront();
+    REQUIRE(table.at(1) == 10);
+
+    // A name can be bound again after its bindings were forgotten.
+    table.pushFront();
+    table.insert(2, 22);
+    REQUIRE(table.at(2) == 22);
+}
+
+TEST_CASE("Only bindings of the innermost scope are contained in front") {
+    auto table = DataStructures::ScopedSymbolTable<int>{};
+    REQUIRE(!table.contains(1));
+    REQUIRE(!table.containsInFront(1));
+    table.insert(1, 10);
+    REQUIRE(table.containsInFront(1));
+
+    table.pushFront();
+    REQUIRE(table.contains(1));
+    REQUIRE(!table.containsInFront(1));
+    table.insert(1, 11);
+    REQUIRE(table.containsInFront(1));
+
+    table.popFront();
+    REQUIRE(table.containsInFront(1));
+}
+
+TEST_CASE("The table grows while scopes are open without losing bindings") {
+    // Far more names than the initial slots, bound across nested scopes
+    // so that the table is rebuilt while shadowed bindings are pending.
+    const int names = 5000;
+    const int scopes = 10;
+    auto table = DataStructures::ScopedSymbolTable<int>{};
+    for (int scope = 0; scope < scopes; scope++) {
+        if (scope > 0) {
+            table.pushFront();
+        }
+        for (int name = 0; name < names; name++) {
+            // Every scope shadows the even names, and binds odd names of its own.
+            if (name % 2 == 0 || name % scopes == scope) {
+                table.insert(name, scope * names + name);
+            }
+        }
+    }
+
+    for (int scope = scopes - 1; scope >= 0; scope--) {
+        for (int name = 0; name < names; name++) {
+            if (name % 2 == 0) {
+                REQUIRE(table.at(name) == scope * names + name);
+                REQUIRE(table.containsInFront(name));
+            } else if (name % scopes <= scope) {
+                REQUIRE(table.at(name) == (name % scopes) * names + name);
+                REQUIRE(table.containsInFront(name) == (name % scopes == scope));
+            } else {
+                REQUIRE(!table.contains(name));
+            }
+        }
+        table.popFront();
+    }
+
+    // Names far apart, including negative ones, hash into the grown table too.
+    table.insert(-7, 1);
+    table.insert(1 << 30, 2);
+    REQUIRE(table.at(-7) == 1);
+    REQUIRE(table.at(1 << 30) == 2);
+}
@@ -0,0 +1,139 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../../../libraries/doctest.h"
+#include "../TreeFold.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Test {
+    /**
+     * A node of a tree to fold, which knows its children like expressions do.
+     */
+    class Node {
+        public:
+            Node(std::string name): _name(name) {}
+            const std::string& name() { return this->_name; }
+            std::vector<Node*>& children() { return this->_children; }
+        private:
+            std::string _name;
+            std::vector<Node*> _children;
+    };
+
+    using TLog = std::vector<std::string>;
+
+    TLog* logPre(TLog* log, Node* node) {
+        log->push_back("pre " + node->name());
+        return log;
+    }
+
+    TLog* logIn(TLog* log, Node* node, int childIndex) {
+        log->push_back("in " + node->name() + " " + std::to_string(childIndex));
+        return log;
+    }
+
+    TLog* logPost(TLog* log, Node* node) {
+        log->push_back("post " + node->name());
+        return log;
+    }
+
+    /**
+     * The depth of the node being folded, the deepest depth seen so far and the amount of nodes left.
+     */
+    struct DDepth {
+        int depth;
+        int deepest;
+        int nodes;
+    };
+
+    DDepth enter(DDepth depth, Node* node) {
+        int current = depth.depth + 1;
+        return DDepth{current, std::max(current, depth.deepest), depth.nodes};
+    }
+
+    DDepth leave(DDepth depth, Node* node) {
+        return DDepth{depth.depth - 1, depth.deepest, depth.nodes + 1};
+    }
+
+    int countNodes(int count, Node* node) {
+        return count + 1;
+    }
+
+    /**
+     * Builds the tree a(b(e, f), c, d), whose nodes live in the given vector.
+     */
+    Node* createTree(std::vector<Node>& nodes) {
+        for (auto name : {"a", "b", "c", "d", "e", "f"}) {
+            nodes.push_back(Node{name});
+        }
+        auto a = &nodes[0];
+        auto b = &nodes[1];
+        a->children() = {b, &nodes[2], &nodes[3]};
+        b->children() = {&nodes[4], &nodes[5]};
+        return a;
+    }
+}
+
+TEST_CASE("Folding functions are called in pre-, in- and post-order") {
+    auto nodes = std::vector<Test::Node>{};
+    auto root = Test::createTree(nodes);
+    auto log = Test::TLog{};
+    auto result = DataStructures::foldTree<Test::logPost, Test::logPre, Test::logIn>(root, &log);
+
+    REQUIRE(result == &log);
+    REQUIRE(log == Test::TLog{
+        "pre a",
+        "pre b",
+        "pre e", "post e", "in b 0",
+        "pre f", "post f", "in b 1",
+        "post b", "in a 0",
+        "pre c", "post c", "in a 1",
+        "pre d", "post d", "in a 2",
+        "post a"
+    });
+}
+
+TEST_CASE("Folding functions that are left out are skipped") {
+    auto nodes = std::vector<Test::Node>{};
+    auto root = Test::createTree(nodes);
+
+    auto preOrder = Test::TLog{};
+    DataStructures::foldTree<nullptr, Test::logPre>(root, &preOrder);
+    REQUIRE(preOrder == Test::TLog{"pre a", "pre b", "pre e", "pre f", "pre c", "pre d"});
+
+    auto postOrder = Test::TLog{};
+    DataStructures::foldTree<Test::logPost>(root, &postOrder);
+    REQUIRE(postOrder == Test::TLog{"post e", "post f", "post b", "post c", "post d", "post a"});
+
+    auto inOrder = Test::TLog{};
+    DataStructures::foldTree<nullptr, nullptr, Test::logIn>(root, &inOrder);
+    REQUIRE(inOrder == Test::TLog{"in b 0", "in b 1", "in a 0", "in a 1", "in a 2"});
+}
+
+TEST_CASE("The accumulator is threaded from each folding function to the next") {
+    auto nodes = std::vector<Test::Node>{};
+    auto root = Test::createTree(nodes);
+
+    REQUIRE(DataStructures::foldTree<Test::countNodes>(root, 0) == 6);
+    auto depth = DataStructures::foldTree<Test::leave, Test::enter>(root, Test::DDepth{0, 0, 0});
+    REQUIRE(depth.depth == 0);
+    REQUIRE(depth.deepest == 3);
+    REQUIRE(depth.nodes == 6);
+
+    auto leaf = Test::Node{"leaf"};
+    REQUIRE(DataStructures::foldTree<Test::countNodes>(&leaf, 0) == 1);
+}
+
+TEST_CASE("Folding a deep degenerate tree does not overflow the stack") {
+    // A chain of a million nodes, each the only child of the one before it.
+    const int depth = 1000000;
+    auto nodes = std::vector<Test::Node>(depth, Test::Node{"n"});
+    for (int i = 0; i + 1 < depth; i++) {
+        nodes[i].children().push_back(&nodes[i + 1]);
+    }
+
+    auto result = DataStructures::foldTree<Test::leave, Test::enter>(&nodes[0], Test::DDepth{0, 0, 0});
+    REQUIRE(result.depth == 0);
+    REQUIRE(result.deepest == depth);
+    REQUIRE(result.nodes == depth);
+}
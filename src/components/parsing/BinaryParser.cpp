@@ -1,4 +1,5 @@
 #include "BinaryParser.h"
+#include "GrammarAnalysis.h"
 #include <iostream>
 #include <cassert>
 
@@ -13,37 +14,61 @@ BinaryParser::BinaryParser(
     
 }
 
-std::shared_ptr<Expression> BinaryParser::parse(std::vector<DToken>& tokens, int position) {
+Parsing::ParseResult BinaryParser::_tryParse(std::vector<DToken>& tokens, int position) {
     // Get the expression preceding the binary operator.
-    auto firstExpression = this->_mapParser.parse(tokens, position);
+    auto firstResult = this->_mapParser.tryParse(tokens, position);
+    if (!firstResult.succeeded()) {
+        return firstResult;
+    }
+    auto& firstExpression = firstResult.expression();
 
     // Peek at the next token.
     auto tokenSequence = TokenSequence{tokens};
     tokenSequence.setPosition(firstExpression->endPos());
-    auto nextToken = tokenSequence.consume();
+    auto& nextToken = tokenSequence.consume();
 
     // If the next token is the operator we were expecting.
-    if (this->_acceptedOperators.contains(nextToken.type)) {
+    if (this->_acceptedOperators.contains(nextToken.kind)) {
         // Get the expression succeeding the binary operator.
-        auto secondExpression = this->_mapParser.parse(tokens, tokenSequence.position());
-
-        // Return the parsed binary expression.
-        auto binaryExpression = std::shared_ptr<Expression>(
-            new Expression{
-                this->_operatorType,
-                position,
-                secondExpression->endPos()
-            }
-        );
-        binaryExpression->tokens().insert(binaryExpression->tokens().end(), nextToken);
-        binaryExpression->subTypes().insert({"name", nextToken.value});
-        Expression::addChild(binaryExpression, firstExpression);
-        Expression::addChild(binaryExpression, secondExpression);
-        return binaryExpression;
+        auto secondResult = this->_mapParser.tryParse(tokens, tokenSequence.position());
+        if (!secondResult.succeeded()) {
+            return secondResult;
+        }
+        return this->combine(firstExpression, nextToken, secondResult.expression());
     } else {
-        throw std::runtime_error(
-            "Expected the binary operator: " + this->_operatorType + " at " + 
-            nextToken.startLocation.toString()
+        return Parsing::ParseResult::failure(
+            Parsing::ParseResult::missingBinaryOperator, 
+            tokenSequence.position() - 1, 
+            &this->_operatorType
         );
     }
+}
+
+Parsing::ParseResult BinaryParser::combine(
+    Expression* firstExpression, 
+    const DToken& operatorToken, 
+    Expression* secondExpression
+) {
+    if (!this->_acceptedOperators.contains(operatorToken.kind)) {
+        return Parsing::ParseResult::failure(
+            Parsing::ParseResult::missingBinaryOperator, 
+            firstExpression->endPos(), 
+            &this->_operatorType
+        );
+    }
+    auto binaryExpression = Expression::create(
+        this->_operatorType,
+        firstExpression->startPos(),
+        secondExpression->endPos()
+    );
+    Expression::addToken(binaryExpression, operatorToken);
+    binaryExpression->subTypes().insert({"name", std::string{operatorToken.value()}});
+    Expression::addChild(binaryExpression, firstExpression);
+    Expression::addChild(binaryExpression, secondExpression);
+    return binaryExpression;
+}
+
+Parsing::FirstSet BinaryParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(&this->_mapParser);
 }
\ No newline at end of file
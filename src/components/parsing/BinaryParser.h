@@ -7,6 +7,7 @@
 #include <string>
 #include <functional>
 #include <set>
+#include "SymbolSet.h"
 #include "TExpressions.h"
 #include "MapParser.h"
 
@@ -21,10 +22,21 @@ class BinaryParser: public IParseable {
             std::set<std::string> acceptedOperators,
             MapParser& mapParser
         );
-        std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+        /**
+         * Joins two already parsed operands with the operator between them into a 
+         * binary expression, failing if the operator is not one of the accepted ones.
+         */
+        Parsing::ParseResult combine(
+            Expression* firstExpression, 
+            const DToken& operatorToken, 
+            Expression* secondExpression
+        );
+        Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+    protected:
+        Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
     private:
         std::string _operatorType;
-        std::set<std::string> _acceptedOperators;
+        Parsing::SymbolSet _acceptedOperators;
         MapParser& _mapParser;
 };
 
@@ -1,67 +1,131 @@
 #include "ChainParser.h"
+#include "GrammarAnalysis.h"
+#include "../data_structures/TreeFold.h"
 #include <iostream>
 
+namespace {
+    // Moves the positions of the expression by the given amount.
+    int shiftPositions(int amount, Expression* expression) {
+        expression->movePositions(amount);
+        return amount;
+    }
+}
+
 Parsing::ChainParser::ChainParser(
     std::string type,
     std::string separator,
     IParseable& parser,
     std::function<bool(std::vector<DToken>& tokens, int position)> separatorOptionalityRule
 ):
-    _type(type), _separator(separator), _parser(parser), _separatorOptionalityRule(separatorOptionalityRule)
+    _type(type), 
+    _separator(separator), 
+    _separatorSymbol(Tokenization::Symbols::id(separator)),
+    _parser(parser), 
+    _separatorOptionalityRule(separatorOptionalityRule)
 {
 }
 
-std::shared_ptr<Expression> Parsing::ChainParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult Parsing::ChainParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	auto sequence = TokenSequence{tokens};
+    auto sequence = TokenSequence{tokens};
     sequence.setPosition(position);
+    return this->_parseChain(sequence, nullptr);
+}
+
+Expression* Parsing::ChainParser::parse(TokenSequence& sequence, std::function<void(TokenSequence&)> prefetch)
+{
+    auto session = ParseSession::current();
+    int sessionOffset = session != nullptr ? session->offset() : 0;
+    auto parseResult = this->_parseChain(sequence, &prefetch);
+    if (session != nullptr) {
+        session->setOffset(sessionOffset);
+    }
+    // A failure is reported right away, while the window still holds its tokens.
+    if (!parseResult.succeeded()) {
+        throw std::runtime_error(parseResult.message(sequence.tokens()));
+    }
+    return parseResult.expression();
+}
+
+Parsing::ParseResult Parsing::ChainParser::_parseChain(TokenSequence& sequence, std::function<void(TokenSequence&)>* prefetch)
+{
+    int position = sequence.position();
+    auto session = ParseSession::current();
 
-    // First, we parse the expressions of the chain.
+    // First, we parse the expressions of the chain. The expression parsers work on the 
+    // tokens held by the sequence, so their positions are relative to its offset.
 
-    auto expressions = std::vector<std::shared_ptr<Expression>>{};
-    auto subTypes = std::map<std::string, std::string>{};
-    std::shared_ptr<Expression> expression;
-    // While there is a parsing rule for the next token.
-    while (this->_parser.canParseAt(tokens, sequence.position())) {
-        // Parse the next expression.
-        expression = this->_parser.parse(tokens, sequence.position());
+    auto expressions = std::vector<Expression*>{};
+    auto openness = std::string{};
+    Expression* expression;
+    while (true) {
+        if (prefetch != nullptr) {
+            (*prefetch)(sequence);
+            // Positions in the window change whenever tokens are released.
+            if (session != nullptr) {
+                session->setOffset(sequence.offset());
+            }
+        }
+        auto& tokens = sequence.tokens();
+        int offset = sequence.offset();
+        // Parse the next expression. The chain ends where nothing can be parsed, 
+        // unless the parser took on the tokens there and then failed.
+        if (!this->_parser.admits(sequence.peek())) {
+            break;
+        }
+        auto parseResult = this->_parser.tryParse(tokens, sequence.position() - offset);
+        if (!parseResult.succeeded()) {
+            if (this->_parser.commitsAt(tokens, sequence.position() - offset)) {
+                return parseResult;
+            }
+            break;
+        }
+        expression = parseResult.expression();
+        if (offset != 0) {
+            DataStructures::foldTree<nullptr, shiftPositions>(expression, offset);
+        }
         expressions.insert(expressions.end(), expression);
 
         // Check whether we should expect a separator to follow the expression.
         sequence.setPosition(expression->endPos());
-        auto separatorIsOptional = this->_separatorOptionalityRule(tokens, sequence.position());
+        auto separatorIsOptional = this->_separatorOptionalityRule(tokens, sequence.position() - offset);
 
         // If we do expect a separator to follow but one is not present.
-        if (!separatorIsOptional && sequence.peek().value != this->_separator) {
-            throw std::runtime_error(
-                "Expected a separator character '" + this->_separator + "' to follow but '" +
-                sequence.peek().value + "' was encountered instead at " + sequence.peek().startLocation.toString() 
-            );
+        if (!separatorIsOptional && sequence.peek().symbol != this->_separatorSymbol) {
+            return ParseResult::failure(ParseResult::missingSeparator, sequence.position() - offset, &this->_separator);
         } else {
             // Skip over potential (optional) following separators.
-            while (sequence.peek().value == this->_separator) {
+            while (sequence.peek().symbol == this->_separatorSymbol) {
                 sequence.consume();
             }
         }
+        // Only the last consumed token is still needed, to tell the openness of the chain.
+        sequence.release(sequence.position() - 1);
     }
 
     // Determine whether the chain has a closing separator or not.
-    if ((sequence.position() > 0) && (sequence.tokens().at(sequence.position() - 1).value != this->_separator)) {
-        subTypes.insert({"openness", "open"});
+    if ((sequence.position() > 0) && (sequence.peek(-1).symbol != this->_separatorSymbol)) {
+        openness = "open";
     } else {
-        subTypes.insert({"openness", "closed"});
+        openness = "closed";
     }
 
     // Next, we form the resulting root expression.
 
-    auto result = std::shared_ptr<Expression>(
-        new Expression{
-            this->_type,
-            position,
-            sequence.position()
-        }
+    auto result = Expression::create(
+        this->_type,
+        position,
+        sequence.position()
     );
     result->setChildren(expressions);
-    result->setSubTypes(subTypes);
+    result->subTypes().insert({"openness", openness});
     return result;
 }
+
+Parsing::FirstSet Parsing::ChainParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    // A chain may have no expressions at all.
+    auto firstSet = analysis.firstSet(&this->_parser);
+    firstSet.setNullable(true);
+    return firstSet;
+}
\ No newline at end of file
@@ -16,10 +16,27 @@ namespace Parsing {
                 IParseable& parser,
                 std::function<bool(std::vector<DToken>& tokens, int position)> separatorOptionalityRule
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            using IParseable::parse;
+            /**
+             * Parses the chain from a streamed sequence, releasing the tokens of each 
+             * expression once it has been parsed. Before each expression, the prefetch 
+             * function has to pull at least all of its tokens into the window, since the 
+             * expression parsers only see the tokens already in it. Throws if the chain fails to parse.
+             */
+            Expression* parse(TokenSequence& sequence, std::function<void(TokenSequence&)> prefetch);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
+            /**
+             * Parses the chain from the position of the sequence, calling the prefetch 
+             * function before each expression if one is given. Streamed sequences 
+             * release the tokens of each expression once it has been parsed.
+             */
+            Parsing::ParseResult _parseChain(TokenSequence& sequence, std::function<void(TokenSequence&)>* prefetch);
             std::string _type;
             std::string _separator;
+            int _separatorSymbol;
             IParseable& _parser;
             std::function<bool(std::vector<DToken>& tokens, int position)> _separatorOptionalityRule;
     };
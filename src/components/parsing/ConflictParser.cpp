@@ -1,32 +1,44 @@
 #include "ConflictParser.h"
+#include "GrammarAnalysis.h"
 #include <iostream>
 
 Parsing::ConflictParser::ConflictParser(std::vector<IParseable*> parsers):
     _parsers(parsers) {
 }
 
-std::shared_ptr<Expression> Parsing::ConflictParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult Parsing::ConflictParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	auto parseResults = std::vector<std::shared_ptr<Expression>>(this->_parsers.size());
-    std::transform(this->_parsers.begin(), this->_parsers.end(), parseResults.begin(), [&tokens, position](auto parser) {
-        try {
-            return parser->parse(tokens, position);
-        } catch (...) {
-            return std::shared_ptr<Expression>(new Expression{"none", -1, -1});
+    // Keep the longest successful parse, preferring earlier rules between equally long ones.
+    Expression* longestExpression = nullptr;
+    // Only the parsers that can start with the next token are tried.
+    auto sequence = TokenSequence{tokens};
+    sequence.setPosition(position);
+    auto& token = sequence.peek();
+    for (auto parser : this->_parsers) {
+        if (!parser->admits(token)) {
+            continue;
         }
-    });
-
-    auto longestExpression = *(std::max_element(
-        parseResults.begin(), 
-        parseResults.end(), 
-        [](auto a, auto b) {
-            return a->endPos() < b->endPos();
+        auto parseResult = parser->tryParse(tokens, position);
+        if (
+            parseResult.succeeded() && 
+            (longestExpression == nullptr || parseResult.expression()->endPos() > longestExpression->endPos())
+        ) {
+            longestExpression = parseResult.expression();
         }
-    ));
+    }
 
-    if (longestExpression->endPos() == -1) {
-        throw std::runtime_error("No parsing rule could be matched at " + tokens.at(position).startLocation.toString());
+    if (longestExpression == nullptr) {
+        return ParseResult::failure(ParseResult::noMatchingRule, position);
     }
 
     return longestExpression;
-}
\ No newline at end of file
+}
+
+Parsing::FirstSet Parsing::ConflictParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    auto firstSet = FirstSet{};
+    for (auto parser : this->_parsers) {
+        firstSet.insert(analysis.firstSet(parser));
+    }
+    return firstSet;
+}
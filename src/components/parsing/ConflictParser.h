@@ -18,7 +18,9 @@ namespace Parsing {
             ConflictParser(
                 std::vector<IParseable*> parsers
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::vector<IParseable*> _parsers;
     };
@@ -1,8 +1,72 @@
 #include "Expression.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 
-Expression::Expression(): _type("__NULL__"), _startPos(-1), _endPos(-1) {
+namespace {
+    // The slots of an expression that hold the values of its attributes.
+    const int nameSlot = 0;
+    const int typeSlot = 1;
+    const int valueSlot = 2;
+    const int opennessSlot = 3;
 
+    // The attributes that expressions can have, and the slots they are stored in. An expression 
+    // has an attribute if the bit of the attribute's key is set in its flags. Attributes are only 
+    // added, and each is published by raising the count, so they are looked up without locking.
+    struct DAttributeKey {
+        std::string name;
+        int slot;
+    };
+    const int mostAttributes = 16;
+    struct DAttributeKeys {
+        DAttributeKey keys[mostAttributes] = {{"name", nameSlot}, {"openness", opennessSlot}};
+        std::atomic<int> count{2};
+        std::mutex mutex;
+    };
+
+    DAttributeKeys& attributeKeys() {
+        static DAttributeKeys keys;
+        return keys;
+    }
+
+    // The flag of blocks that are open, that is, not ended with a separator.
+    const int openFlag = 1 << 16;
+    const std::string open = "open";
+    const std::string closed = "closed";
+
+    int attributeIndex(const std::string& name) {
+        auto& keys = attributeKeys();
+        int count = keys.count.load(std::memory_order_acquire);
+        for (int i = 0; i < count; i++) {
+            if (keys.keys[i].name == name) {
+                return i;
+            }
+        }
+        return -1;
+    }
+}
+
+Expression::Expression(): 
+	_arena(nullptr), 
+	_children(nullptr), 
+	_childCount(0), 
+	_childCapacity(0), 
+	_parent(nullptr), 
+	_tokens(nullptr), 
+	_tokenCount(0), 
+	_tokenCapacity(0), 
+	_startPos(-1), 
+	_endPos(-1), 
+	_name(Parsing::Names::none), 
+	_valueType(Parsing::Names::none), 
+	_value(nullptr), 
+	_flags(0), 
+	_source(nullptr), 
+	_spanStart(-1), 
+	_spanEnd(-1) {
+	// Arenas create expressions in large batches, so the kind of empty expressions is interned only once.
+	static const int nullKind = Parsing::Names::id("__NULL__");
+	this->_kind = nullKind;
 }
 
 Expression::Expression(
@@ -10,74 +74,210 @@ Expression::Expression(
 	int startPos, 
 	int endPos
 ):
-	_type(type), _startPos(startPos), _endPos(endPos)
+	_arena(nullptr), 
+	_children(nullptr), 
+	_childCount(0), 
+	_childCapacity(0), 
+	_parent(nullptr), 
+	_tokens(nullptr), 
+	_tokenCount(0), 
+	_tokenCapacity(0), 
+	_kind(Parsing::Names::id(type)), 
+	_startPos(startPos), 
+	_endPos(endPos), 
+	_name(Parsing::Names::none), 
+	_valueType(Parsing::Names::none), 
+	_value(nullptr), 
+	_flags(0), 
+	_source(nullptr), 
+	_spanStart(-1), 
+	_spanEnd(-1)
 {
 }
 
+Expression* Expression::create(std::string type, int startPos, int endPos)
+{
+	return Parsing::ExpressionArena::current().create(type, startPos, endPos);
+}
+
+int Expression::registerAttribute(const std::string& name, EAttributeSlot slot)
+{
+	auto& keys = attributeKeys();
+	std::lock_guard<std::mutex> lock(keys.mutex);
+	int index = attributeIndex(name);
+	if (index != -1) {
+		if (keys.keys[index].slot != (int) slot) {
+			throw std::runtime_error("The attribute " + name + " is already stored in another slot.");
+		}
+		return index;
+	}
+	int count = keys.count.load(std::memory_order_relaxed);
+	if (count == mostAttributes) {
+		throw std::runtime_error("Expressions cannot have more than " + std::to_string(mostAttributes) + " attributes.");
+	}
+	keys.keys[count] = DAttributeKey{name, (int) slot};
+	keys.count.store(count + 1, std::memory_order_release);
+	return count;
+}
+
 void Expression::setType(std::string type) {
-	this->_type = type;
+	this->_kind = Parsing::Names::id(type);
 }
 
 Text::Location Expression::startLocation() {
-	auto childLocation = this->_children.size() > 0 ? this->_children.front()->startLocation() : Text::Location{};
-	auto firstTokenLocation = this->_tokens.size() > 0 ? this->_tokens.front().startLocation : Text::Location{};
-	if (firstTokenLocation.positionIndex() == -1) {
-		return childLocation;
-	} else if (childLocation.positionIndex() == -1) {
-		return firstTokenLocation;
-	} else if (childLocation.positionIndex() < firstTokenLocation.positionIndex()) {
-		return childLocation;
-	} else {
-		return firstTokenLocation;
-	}
+	return this->_spanStart != -1 ? this->_source->location(this->_spanStart) : Text::Location{};
 }
 
 Text::Location Expression::endLocation() {
-	auto childLocation = this->_children.size() > 0 ? this->_children.back()->endLocation() : Text::Location{};
-	auto firstTokenLocation = this->_tokens.size() > 0 ? this->_tokens.back().endLocation : Text::Location{};
-	if (firstTokenLocation.positionIndex() == -1) {
-		return childLocation;
-	} else if (childLocation.positionIndex() == -1) {
-		return firstTokenLocation;
-	} else if (childLocation.positionIndex() > firstTokenLocation.positionIndex()) {
-		return childLocation;
-	} else {
-		return firstTokenLocation;
+	return this->_spanEnd != -1 ? this->_source->location(this->_spanEnd) : Text::Location{};
+}
+
+Expression::Attributes Expression::subTypes()
+{
+	return Attributes{this};
+}
+
+const std::string& Expression::Attributes::at(const std::string& key) const
+{
+	int index = attributeIndex(key);
+	if (index == -1 || (this->_expression->_flags & (1 << index)) == 0) {
+		throw std::out_of_range("The expression has no attribute " + key + ".");
+	}
+	switch (attributeKeys().keys[index].slot) {
+		case nameSlot:
+			return Parsing::Names::name(this->_expression->_name);
+		case typeSlot:
+			return Parsing::Names::name(this->_expression->_valueType);
+		case valueSlot:
+			return *this->_expression->_value;
+		default:
+			return (this->_expression->_flags & openFlag) != 0 ? open : closed;
 	}
 }
 
-std::map<std::string, std::string>& Expression::subTypes()
+bool Expression::Attributes::contains(const std::string& key) const
 {
-	return this->_subTypes;
+	int index = attributeIndex(key);
+	return index != -1 && (this->_expression->_flags & (1 << index)) != 0;
 }
 
-void Expression::setSubTypes(std::map<std::string, std::string> subTypes)
+void Expression::Attributes::insert(const std::pair<std::string, std::string>& attribute)
 {
-	this->_subTypes = subTypes;
+	auto& [key, value] = attribute;
+	int index = attributeIndex(key);
+	if (index == -1) {
+		throw std::runtime_error("Expressions have no attribute " + key + ", since it has not been registered.");
+	}
+	if ((this->_expression->_flags & (1 << index)) != 0) {
+		return;
+	}
+	auto& keys = attributeKeys();
+	int slot = keys.keys[index].slot;
+	int count = keys.count.load(std::memory_order_acquire);
+	for (int other = 0; other < count; other++) {
+		if (keys.keys[other].slot == slot && (this->_expression->_flags & (1 << other)) != 0) {
+			throw std::runtime_error(
+				"The expression cannot have both the attributes " + key + " and " + keys.keys[other].name + "."
+			);
+		}
+	}
+	this->_expression->_flags = this->_expression->_flags | (1 << index);
+	switch (slot) {
+		case nameSlot:
+			this->_expression->_name = Parsing::Names::id(value);
+			break;
+		case typeSlot:
+			this->_expression->_valueType = Parsing::Names::id(value);
+			break;
+		case valueSlot:
+			this->_expression->_value = this->_expression->_ownArena().storeValue(value);
+			break;
+		default:
+			if (value == open) {
+				this->_expression->_flags = this->_expression->_flags | openFlag;
+			}
+	}
 }
 
-std::vector<DToken>& Expression::tokens()
+void Expression::Attributes::insert_or_assign(const std::string& key, const std::string& value)
 {
-	return this->_tokens;
+	int index = attributeIndex(key);
+	if (index != -1) {
+		int cleared = attributeKeys().keys[index].slot == opennessSlot ? (1 << index) | openFlag : 1 << index;
+		this->_expression->_flags = this->_expression->_flags & ~cleared;
+	}
+	this->insert({key, value});
+}
+
+bool Expression::Attributes::operator==(const Attributes& other) const
+{
+	auto first = this->_expression;
+	auto second = other._expression;
+	return first->_flags == second->_flags 
+		&& first->_name == second->_name 
+		&& first->_valueType == second->_valueType 
+		&& (
+			first->_value == second->_value || 
+			(first->_value != nullptr && second->_value != nullptr && *first->_value == *second->_value)
+		);
+}
+
+Expression::Tokens Expression::tokens()
+{
+	return Tokens{this->_tokens, this->_tokenCount};
 }
 
 void Expression::setTokens(std::vector<DToken> tokens)
 {
-	this->_tokens = tokens;
+	this->_tokens = tokens.size() > 0 ? this->_ownArena().allocateTokens((int) tokens.size()) : nullptr;
+	this->_tokenCount = (int) tokens.size();
+	this->_tokenCapacity = (int) tokens.size();
+	std::copy(tokens.begin(), tokens.end(), this->_tokens);
+	this->_updateSpan();
 }
 
-DToken Expression::rootToken()
+const DToken& Expression::rootToken()
 {
-	if (this->_tokens.size() > 0) {
-		return this->_tokens.at(0);
+	if (this->_tokenCount > 0) {
+		return this->_tokens[0];
 	} else {
 		throw std::runtime_error("The Expression has no root token.");
 	}
 }
 
-std::string Expression::type()
+const std::string& Expression::type()
+{
+	return Parsing::Names::name(this->_kind);
+}
+
+int Expression::kind()
+{
+	return this->_kind;
+}
+
+int Expression::nameId()
+{
+	return (this->_flags & 1) != 0 ? this->_name : Parsing::Names::none;
+}
+
+int Expression::attributeId(int key)
+{
+	if ((this->_flags & (1 << key)) == 0) {
+		return Parsing::Names::none;
+	}
+	switch (attributeKeys().keys[key].slot) {
+		case nameSlot:
+			return this->_name;
+		case typeSlot:
+			return this->_valueType;
+		default:
+			return Parsing::Names::none;
+	}
+}
+
+int Expression::typeId()
 {
-	return this->_type;
+	return this->_valueType;
 }
 
 int Expression::startPos()
@@ -98,27 +298,39 @@ int Expression::endPos()
 void Expression::setEndPos(int endPos)
 {
 	this->_endPos = endPos;
-	if (this->_parent && this->isLastChild() && this->_parent->endPos() < this->_endPos) {
-		this->_parent->setEndPos(this->_endPos);
+	auto expression = this;
+	while (expression->_parent && expression->isLastChild() && expression->_parent->_endPos < endPos) {
+		expression->_parent->_endPos = endPos;
+		expression = expression->_parent;
 	}
 }
 
-std::vector<std::shared_ptr<Expression>>& Expression::children()
+void Expression::movePositions(int amount)
 {
-	return this->_children;
+	this->_startPos = this->_startPos + amount;
+	this->_endPos = this->_endPos + amount;
 }
 
-void Expression::setChildren(std::vector<std::shared_ptr<Expression>> children)
+Expression::Children Expression::children()
 {
-	this->_children = children;
+	return Children{this->_children, this->_childCount};
 }
 
-std::shared_ptr<Expression> Expression::parent()
+void Expression::setChildren(std::vector<Expression*> children)
+{
+	this->_children = children.size() > 0 ? this->_ownArena().allocateChildren((int) children.size()) : nullptr;
+	this->_childCount = (int) children.size();
+	this->_childCapacity = (int) children.size();
+	std::copy(children.begin(), children.end(), this->_children);
+	this->_updateSpan();
+}
+
+Expression* Expression::parent()
 {
 	return this->_parent;
 }
 
-void Expression::setParent(std::shared_ptr<Expression> parent)
+void Expression::setParent(Expression* parent)
 {
     this->_parent = parent;
 }
@@ -129,7 +341,7 @@ std::vector<std::string> Expression::extractChildSubTypeValues(std::string type,
 	std::for_each(
 		this->children().begin(), 
 		this->children().end(), 
-		[&result, &type, &subType](std::shared_ptr<Expression> child) {
+		[&result, &type, &subType](Expression* child) {
 			if (type != "*" && child->type() == type) {
 				auto value = child->subTypes().at(subType);
 				result.insert(result.end(), value);
@@ -139,7 +351,7 @@ std::vector<std::string> Expression::extractChildSubTypeValues(std::string type,
 	return result;
 }
 
-std::shared_ptr<Expression> Expression::earliestAncestor(std::shared_ptr<Expression> expression)
+Expression* Expression::earliestAncestor(Expression* expression)
 {
 	if (expression->parent()) {
 		auto parent = expression->parent();
@@ -154,42 +366,71 @@ std::shared_ptr<Expression> Expression::earliestAncestor(std::shared_ptr<Express
 	}
 }
 
-void Expression::addChild(std::shared_ptr<Expression> expression, std::shared_ptr<Expression> child)
+void Expression::addChild(Expression* expression, Expression* child)
 {
-    expression->children().insert(expression->children().end(), child);
+	// A full list of children moves into twice the room, so that adding children takes amortized constant time.
+	if (expression->_childCount == expression->_childCapacity) {
+		int capacity = std::max(2, 2 * expression->_childCapacity);
+		auto children = expression->_ownArena().allocateChildren(capacity);
+		std::copy(expression->_children, expression->_children + expression->_childCount, children);
+		expression->_children = children;
+		expression->_childCapacity = capacity;
+	}
+	expression->_children[expression->_childCount] = child;
+	expression->_childCount = expression->_childCount + 1;
 	if (child->endPos() > expression->endPos()) {
 		expression->setEndPos(child->endPos());
 	}
     child->setParent(expression);
+	expression->_updateSpan();
+}
+
+void Expression::addToken(Expression* expression, const DToken& token)
+{
+	if (expression->_tokenCount == expression->_tokenCapacity) {
+		int capacity = std::max(2, 2 * expression->_tokenCapacity);
+		auto tokens = expression->_ownArena().allocateTokens(capacity);
+		std::copy(expression->_tokens, expression->_tokens + expression->_tokenCount, tokens);
+		expression->_tokens = tokens;
+		expression->_tokenCapacity = capacity;
+	}
+	expression->_tokens[expression->_tokenCount] = token;
+	expression->_tokenCount = expression->_tokenCount + 1;
+	expression->_updateSpan();
 }
 
-void Expression::removeChild(std::shared_ptr<Expression> expression, std::shared_ptr<Expression> child) {
-	auto childInChildren = std::find(expression->children().begin(), expression->children().end(), child);
-	if (childInChildren != expression->children().end()) {
-		expression->children().erase(childInChildren);
-		child->setParent(std::shared_ptr<Expression>());
+void Expression::removeChild(Expression* expression, Expression* child) {
+	auto end = expression->_children + expression->_childCount;
+	auto childInChildren = std::find(expression->_children, end, child);
+	if (childInChildren != end) {
+		std::copy(childInChildren + 1, end, childInChildren);
+		expression->_childCount = expression->_childCount - 1;
+		child->setParent(nullptr);
+		expression->_updateSpan();
 	}
 }
 
 void Expression::replaceChild(
-	std::shared_ptr<Expression> expression, 
-	std::shared_ptr<Expression> replacer, 
-	std::shared_ptr<Expression> replacee
+	Expression* expression, 
+	Expression* replacer, 
+	Expression* replacee
 ) {
-	auto child = std::find(expression->children().begin(), expression->children().end(), replacee);
-	if (child != expression->children().end()) {
+	auto end = expression->_children + expression->_childCount;
+	auto child = std::find(expression->_children, end, replacee);
+	if (child != end) {
 		replacer->setParent(expression);
-		replacee->setParent(std::shared_ptr<Expression>());
+		replacee->setParent(nullptr);
 		*child = replacer;
+		expression->_updateSpan();
 	}
 }
 
-void Expression::replaceAsParent(std::shared_ptr<Expression> replacer, std::shared_ptr<Expression> replacee) {
+void Expression::replaceAsParent(Expression* replacer, Expression* replacee) {
 	Expression::replace(replacer, replacee);
 	Expression::addChild(replacer, replacee);
 }
 
-void Expression::replace(std::shared_ptr<Expression> replacer, std::shared_ptr<Expression> replacee) {
+void Expression::replace(Expression* replacer, Expression* replacee) {
 	auto parent = replacee->parent();
 	if (parent) {
 		Expression::replaceChild(parent, replacer, replacee);
@@ -198,16 +439,93 @@ void Expression::replace(std::shared_ptr<Expression> replacer, std::shared_ptr<E
 
 bool Expression::isLastChild()
 {
-	if (this->_parent && this->_parent->children().size() > 0) {
-		auto selfInParent = std::find_if(
-			this->_parent->children().begin(), 
-			this->_parent->children().end(), 
-			[this](std::shared_ptr<Expression> child) {
-				return child.get() == this;
-			}
-		);
-		return (selfInParent == this->_parent->children().end() - 1);
-	} else {
-		return false;
+	return this->_parent && this->_parent->_childCount > 0 && this->_parent->_children[this->_parent->_childCount - 1] == this;
+}
+
+Expression* Expression::clone(Expression* expression)
+{
+    auto copy = Expression::create(expression->type(), expression->startPos(), expression->endPos());
+    copy->_name = expression->_name;
+    copy->_valueType = expression->_valueType;
+    copy->_value = expression->_value != nullptr ? copy->_ownArena().storeValue(*expression->_value) : nullptr;
+    copy->_flags = expression->_flags;
+    copy->setTokens(expression->tokens());
+    copy->setParent(expression->parent());
+    auto children = std::vector<Expression*>{};
+    for (auto child : expression->children()) {
+        auto childCopy = Expression::clone(child);
+        if (child->parent() == expression) {
+            childCopy->setParent(copy);
+        }
+        children.push_back(childCopy);
+    }
+    copy->setChildren(children);
+    return copy;
+}
+
+Expression* Expression::copy(Expression* expression)
+{
+    auto copy = Expression::create(expression->type(), expression->startPos(), expression->endPos());
+    copy->_name = expression->_name;
+    copy->_valueType = expression->_valueType;
+    copy->_value = expression->_value;
+    copy->_flags = expression->_flags;
+    copy->setTokens(expression->tokens());
+    copy->setChildren(expression->children());
+    return copy;
+}
+
+int Expression::size(Expression* expression)
+{
+    int size = 1;
+    for (auto child : expression->children()) {
+        size = size + Expression::size(child);
+    }
+    return size;
+}
+
+Parsing::ExpressionArena& Expression::_ownArena()
+{
+	return this->_arena != nullptr ? *this->_arena : Parsing::ExpressionArena::current();
+}
+
+void Expression::_updateSpan()
+{
+	// The span starts where the first token or the first child starts, whichever is first, 
+	// and ends where the last token or the last child ends, whichever is last.
+	const Text::Source* startSource = nullptr;
+	const Text::Source* endSource = nullptr;
+	int start = -1;
+	int end = -1;
+	if (this->_childCount > 0) {
+		auto first = this->_children[0];
+		auto last = this->_children[this->_childCount - 1];
+		startSource = first->_source;
+		start = first->_spanStart;
+		endSource = last->_source;
+		end = last->_spanEnd;
+	}
+	if (this->_tokenCount > 0) {
+		auto& first = this->_tokens[0];
+		auto& last = this->_tokens[this->_tokenCount - 1];
+		if (start == -1 || start >= first.startPos()) {
+			startSource = first.source;
+			start = first.startPos();
+		}
+		if (end == -1 || end <= last.endPos()) {
+			endSource = last.source;
+			end = last.endPos();
+		}
+	}
+	auto source = startSource != nullptr ? startSource : endSource;
+	if (start == this->_spanStart && end == this->_spanEnd && source == this->_source) {
+		return;
 	}
-}
\ No newline at end of file
+	this->_source = source;
+	this->_spanStart = start;
+	this->_spanEnd = end;
+	auto parent = this->_parent;
+	if (parent && parent->_childCount > 0 && (parent->_children[0] == this || this->isLastChild())) {
+		parent->_updateSpan();
+	}
+}
@@ -4,60 +4,204 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <map>
+#include <stdexcept>
 #include "../tokenization/DToken.h"
 #include "../text/Location.h"
+#include "ExpressionArena.h"
+#include "Names.h"
 
 /**
- * A node in the Abstract Syntax Tree of a language being parsed.
+ * A node in the Abstract Syntax Tree of a language being parsed. Expressions live in 
+ * the ExpressionArena they were created in, and are created with Expression::create.
  */
 class Expression {
     public:
+        /**
+         * A view of a list held by an expression, such as its children or tokens. It 
+         * reflects later changes to the list only until the list is moved to make room 
+         * for more, so it is best copied into a vector when the list is about to change.
+         */
+        template<class T>
+        class Range {
+            public:
+                Range(const T* begin, int size): _begin(begin), _size(size) {}
+                const T* begin() const { return this->_begin; }
+                const T* end() const { return this->_begin + this->_size; }
+                std::size_t size() const { return (std::size_t) this->_size; }
+                bool empty() const { return this->_size == 0; }
+                const T& operator[](int index) const { return this->_begin[index]; }
+                const T& at(int index) const {
+                    if (index < 0 || index >= this->_size) {
+                        throw std::out_of_range("The expression has no element at the index.");
+                    }
+                    return this->_begin[index];
+                }
+                const T& front() const { return this->_begin[0]; }
+                const T& back() const { return this->_begin[this->_size - 1]; }
+                operator std::vector<T>() const {
+                    return std::vector<T>(this->begin(), this->end());
+                }
+            private:
+                const T* _begin;
+                int _size;
+        };
+        using Children = Range<Expression*>;
+        using Tokens = Range<DToken>;
+        /**
+         * The slots of an expression that the values of its attributes are stored in. Names 
+         * and types are interned, while other values, such as those of literals, are kept 
+         * in the arena of the expression.
+         */
+        enum class EAttributeSlot {
+            name,
+            type,
+            value
+        };
+        /**
+         * A view of the attributes of an expression by their names, such as "name" or 
+         * "value-type". The attributes are stored in a few slots of the expression: 
+         * names in one, types in another, other values in a third and the openness 
+         * of blocks as flags. Attributes that share a slot cannot be given to the 
+         * same expression.
+         */
+        class Attributes {
+            public:
+                Attributes(Expression* expression): _expression(expression) {}
+                /**
+                 * Returns the value of the attribute, throwing a std::out_of_range if the 
+                 * expression has no such attribute.
+                 */
+                const std::string& at(const std::string& key) const;
+                bool contains(const std::string& key) const;
+                /**
+                 * Gives the attribute to the expression unless it already has it.
+                 */
+                void insert(const std::pair<std::string, std::string>& attribute);
+                /**
+                 * Gives the attribute to the expression, replacing any value it had before.
+                 */
+                void insert_or_assign(const std::string& key, const std::string& value);
+                bool operator==(const Attributes& other) const;
+            private:
+                Expression* _expression;
+        };
         Expression();
+        /**
+         * Creates an expression in the current arena of the thread.
+         */
+        static Expression* create(std::string type, int startPos, int endPos);
+        /**
+         * Lets expressions have the attribute of the given name, stored in the given slot, and 
+         * returns the key of the attribute. The parsers of this component give expressions the 
+         * "name" and "openness" attributes, and languages register the other attributes of their 
+         * trees before giving them to expressions. Registering an attribute again returns its key.
+         */
+        static int registerAttribute(const std::string& name, EAttributeSlot slot);
         Expression(std::string type, int startPos, int endPos);
         void setType(std::string type);
+        /**
+         * The location in the source where the expression starts, found from its first 
+         * token and first child. Spans are kept up to date as tokens and children are 
+         * added and removed, so this does not look into the children.
+         */
         Text::Location startLocation();
         Text::Location endLocation();
-        std::map<std::string, std::string>& subTypes();
-        void setSubTypes(std::map<std::string, std::string> subTypes);
-        std::vector<DToken>& tokens();
+        Attributes subTypes();
+        Tokens tokens();
         void setTokens(std::vector<DToken> tokens);
-        DToken rootToken();
-        std::string type();
+        const DToken& rootToken();
+        const std::string& type();
+        /**
+         * The interned id of the type of the expression.
+         */
+        int kind();
+        /**
+         * The interned id of the "name" attribute, or Parsing::Names::none.
+         */
+        int nameId();
+        /**
+         * The interned id of the name or type attribute with the given key, or Parsing::Names::none 
+         * if the expression does not have the attribute or the attribute is not interned.
+         */
+        int attributeId(int key);
+        /**
+         * The interned id of the type attribute of the expression, such as its 
+         * "value-type" or "return-type", or Parsing::Names::none.
+         */
+        int typeId();
         int startPos();
         void setStartPos(int endPos);
         int endPos();
         void setEndPos(int endPos);
-        std::vector<std::shared_ptr<Expression>>& children();
-        void setChildren(std::vector<std::shared_ptr<Expression>> children);
-        std::shared_ptr<Expression> parent();
-        void setParent(std::shared_ptr<Expression> parent);
+        /**
+         * Moves the start and end positions of the expression by the given amount, 
+         * leaving the positions of its parent as they are.
+         */
+        void movePositions(int amount);
+        Children children();
+        void setChildren(std::vector<Expression*> children);
+        Expression* parent();
+        void setParent(Expression* parent);
         bool isLastChild();
         /**
          * Get the sub-type values of the expression's children. If the given type parameter is not 
          * '*', will only return sub-type values for children who have the given type.
          */
         std::vector<std::string> extractChildSubTypeValues(std::string type, std::string subType);
-        static std::shared_ptr<Expression> earliestAncestor(std::shared_ptr<Expression> expression);
-        static void addChild(std::shared_ptr<Expression> expression, std::shared_ptr<Expression> child);
-        static void removeChild(std::shared_ptr<Expression> expression, std::shared_ptr<Expression> child);
+        static Expression* earliestAncestor(Expression* expression);
+        static void addChild(Expression* expression, Expression* child);
+        static void addToken(Expression* expression, const DToken& token);
+        static void removeChild(Expression* expression, Expression* child);
         static void replaceChild(
-            std::shared_ptr<Expression> expression, 
-            std::shared_ptr<Expression> replacer, 
-            std::shared_ptr<Expression> replacee
+            Expression* expression, 
+            Expression* replacer, 
+            Expression* replacee
         );
-        static void replaceAsParent(std::shared_ptr<Expression> replacer, std::shared_ptr<Expression> replacee);
-        static void replace(std::shared_ptr<Expression> replacer, std::shared_ptr<Expression> replacee);
+        static void replaceAsParent(Expression* replacer, Expression* replacee);
+        static void replace(Expression* replacer, Expression* replacee);
+        /**
+         * Copies the expression and all of its descendants. The copied descendants 
+         * have the copies of their parents as parents.
+         */
+        static Expression* clone(Expression* expression);
+        /**
+         * Copies the expression without its descendants, which the copy shares with 
+         * the expression, as it shares the values of the attributes. The copy has no parent. Parsers rework copies of the 
+         * expressions they receive, since those may be shared through the memo 
+         * table of the parse session.
+         */
+        static Expression* copy(Expression* expression);
+        /**
+         * The amount of expressions in the tree rooted at the expression.
+         */
+        static int size(Expression* expression);
     private:
-        Text::Location _startLocation;
-        Text::Location _endLocation;
-        std::map<std::string, std::string> _subTypes;
-        std::vector<std::shared_ptr<Expression>> _children;
-        std::shared_ptr<Expression> _parent;
-        std::string _type;
+        friend class Parsing::ExpressionArena;
+        Parsing::ExpressionArena& _ownArena();
+        /**
+         * Recomputes the span of the expression from its first and last token and child, 
+         * and the span of its parent too if the expression is its first or last child.
+         */
+        void _updateSpan();
+        Parsing::ExpressionArena* _arena;
+        Expression** _children;
+        int _childCount;
+        int _childCapacity;
+        Expression* _parent;
+        DToken* _tokens;
+        int _tokenCount;
+        int _tokenCapacity;
+        int _kind;
         int _startPos;
         int _endPos;
-        std::vector<DToken> _tokens;
+        int _name;
+        int _valueType;
+        const std::string* _value;
+        int _flags;
+        // The span of the expression as offsets in its source, or -1 if it has no tokens.
+        const Text::Source* _source;
+        int _spanStart;
+        int _spanEnd;
 };
 
-#endif
\ No newline at end of file
+#endif
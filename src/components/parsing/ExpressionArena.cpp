@@ -0,0 +1,112 @@
+#include "ExpressionArena.h"
+#include "Expression.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    thread_local Parsing::ExpressionArena* currentArena = nullptr;
+
+    // The amounts of expressions and list slots in each block, which grow up to the largest sizes.
+    const int firstBlockSize = 64;
+    const int largestBlockSize = 4096;
+    const int firstSlotBlockSize = 256;
+    const int largestSlotBlockSize = 16384;
+}
+
+Parsing::ExpressionArena::ExpressionArena():
+    _blockSize(firstBlockSize / 2), 
+    _usedInBlock(0), 
+    _childSlots{{}, nullptr, firstSlotBlockSize / 2, 0}, 
+    _tokenSlots{{}, nullptr, firstSlotBlockSize / 2, 0}, 
+    _size(0), 
+    _bytes(0) {
+
+}
+
+Parsing::ExpressionArena::Scope::Scope(ExpressionArena& arena):
+    _previous(currentArena) {
+    currentArena = &arena;
+}
+
+Parsing::ExpressionArena::Scope::~Scope() {
+    currentArena = this->_previous;
+}
+
+Parsing::ExpressionArena& Parsing::ExpressionArena::current()
+{
+    assert(currentArena != nullptr && "Expressions can only be created within the scope of an arena.");
+    return *currentArena;
+}
+
+Expression* Parsing::ExpressionArena::create(std::string type, int startPos, int endPos)
+{
+    if (this->_blocks.empty() || this->_usedInBlock == this->_blockSize) {
+        this->_blockSize = std::min(2 * this->_blockSize, largestBlockSize);
+        this->_blocks.push_back(std::unique_ptr<Expression[]>(new Expression[this->_blockSize]));
+        this->_bytes = this->_bytes + this->_blockSize * sizeof(Expression);
+        this->_usedInBlock = 0;
+    }
+    auto expression = &this->_blocks.back()[this->_usedInBlock];
+    this->_usedInBlock = this->_usedInBlock + 1;
+    this->_size = this->_size + 1;
+    expression->_arena = this;
+    expression->setType(type);
+    expression->setStartPos(startPos);
+    expression->setEndPos(endPos);
+    return expression;
+}
+
+Expression** Parsing::ExpressionArena::allocateChildren(int capacity)
+{
+    return this->_allocate(this->_childSlots, capacity);
+}
+
+DToken* Parsing::ExpressionArena::allocateTokens(int capacity)
+{
+    return this->_allocate(this->_tokenSlots, capacity);
+}
+
+const std::string* Parsing::ExpressionArena::storeValue(std::string_view value)
+{
+    this->_values.emplace_back(value);
+    this->_bytes = this->_bytes + sizeof(std::string) + value.size();
+    return &this->_values.back();
+}
+
+template<class T>
+T* Parsing::ExpressionArena::_allocate(DSlots<T>& slots, int capacity)
+{
+    // Lists longer than a fraction of a block get a block of their own.
+    if (capacity > largestSlotBlockSize / 4) {
+        slots.blocks.push_back(std::unique_ptr<T[]>(new T[capacity]));
+        this->_bytes = this->_bytes + capacity * sizeof(T);
+        return slots.blocks.back().get();
+    }
+    if (slots.block == nullptr || slots.used + capacity > slots.blockSize) {
+        slots.blockSize = std::max(std::min(2 * slots.blockSize, largestSlotBlockSize), capacity);
+        slots.blocks.push_back(std::unique_ptr<T[]>(new T[slots.blockSize]));
+        this->_bytes = this->_bytes + slots.blockSize * sizeof(T);
+        slots.block = slots.blocks.back().get();
+        slots.used = 0;
+    }
+    auto allocated = slots.block + slots.used;
+    slots.used = slots.used + capacity;
+    return allocated;
+}
+
+void Parsing::ExpressionArena::adopt(std::unique_ptr<ExpressionArena> arena)
+{
+    this->_size = this->_size + arena->size();
+    this->_bytes = this->_bytes + arena->bytes();
+    this->_adopted.push_back(std::move(arena));
+}
+
+std::size_t Parsing::ExpressionArena::size()
+{
+    return this->_size;
+}
+
+std::size_t Parsing::ExpressionArena::bytes()
+{
+    return this->_bytes;
+}
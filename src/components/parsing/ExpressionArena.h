@@ -0,0 +1,98 @@
+#ifndef PARSING_EXPRESSION_ARENA_HH
+#define PARSING_EXPRESSION_ARENA_HH
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Expression;
+struct DToken;
+
+namespace Parsing {
+    /**
+     * Owns the expressions of one compilation. Expressions are allocated in large blocks 
+     * and the lists of their children and tokens in blocks of slots, and all of them are 
+     * released at once when the arena is destroyed. Expressions refer to each other by plain pointers 
+     * that stay valid for the lifetime of the arena, so trees need no reference counting.
+     *
+     * Expressions are created in the current arena of the thread, which is set by an 
+     * ExpressionArena::Scope. Whoever sets the scope owns the expressions created in it, 
+     * so creating expressions outside of any scope is an error.
+     */
+    class ExpressionArena {
+        public:
+            ExpressionArena();
+            ExpressionArena(const ExpressionArena&) = delete;
+            ExpressionArena& operator=(const ExpressionArena&) = delete;
+            /**
+             * Makes an arena the current one of the thread until the scope ends.
+             */
+            class Scope {
+                public:
+                    Scope(ExpressionArena& arena);
+                    ~Scope();
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+                private:
+                    ExpressionArena* _previous;
+            };
+            /**
+             * The arena of the innermost scope of the thread. There has to be one.
+             */
+            static ExpressionArena& current();
+            Expression* create(std::string type, int startPos, int endPos);
+            /**
+             * Allocates room for a list of the given amount of children. The 
+             * slots stay where they are until the arena is destroyed.
+             */
+            Expression** allocateChildren(int capacity);
+            /**
+             * Allocates room for a list of the given amount of tokens, like allocateChildren.
+             */
+            DToken* allocateTokens(int capacity);
+            /**
+             * Keeps a copy of an attribute value that is not worth interning, such as the 
+             * value of a literal, for as long as the arena lives.
+             */
+            const std::string* storeValue(std::string_view value);
+            /**
+             * Takes over another arena, for example one that another thread has parsed 
+             * into, so that its expressions live as long as the expressions of this arena.
+             */
+            void adopt(std::unique_ptr<ExpressionArena> arena);
+            /**
+             * The amount of expressions created in the arena.
+             */
+            std::size_t size();
+            /**
+             * The memory held by the arena for expressions, their lists of children and tokens, and their values.
+             */
+            std::size_t bytes();
+        private:
+            std::vector<std::unique_ptr<Expression[]>> _blocks;
+            int _blockSize;
+            int _usedInBlock;
+            // Blocks of slots for lists of one type of element.
+            template<class T>
+            struct DSlots {
+                std::vector<std::unique_ptr<T[]>> blocks;
+                T* block;
+                int blockSize;
+                int used;
+            };
+            template<class T>
+            T* _allocate(DSlots<T>& slots, int capacity);
+            DSlots<Expression*> _childSlots;
+            DSlots<DToken> _tokenSlots;
+            // A deque keeps the values where they are as more are added.
+            std::deque<std::string> _values;
+            std::vector<std::unique_ptr<ExpressionArena>> _adopted;
+            std::size_t _size;
+            std::size_t _bytes;
+    };
+};
+
+#endif
@@ -1,9 +1,9 @@
 #include "ExpressionFactory.h"
 
-std::shared_ptr<Expression> Parsing::ExpressionFactory::createBinaryOperation(
+Expression* Parsing::ExpressionFactory::createBinaryOperation(
     std::string operationName, 
-    std::shared_ptr<Expression> leftChild,
-    std::shared_ptr<Expression> rightChild
+    Expression* leftChild,
+    Expression* rightChild
 ) {
-	return std::shared_ptr<Expression>(nullptr);
+	return nullptr;
 }
\ No newline at end of file
@@ -11,10 +11,10 @@ namespace Parsing {
             /**
              * Create an expression equivalent to what the BinaryParser would produce.
              */
-            std::shared_ptr<Expression> createBinaryOperation(
+            Expression* createBinaryOperation(
                 std::string operationName, 
-                std::shared_ptr<Expression> leftChild,
-                std::shared_ptr<Expression> rightChild
+                Expression* leftChild,
+                Expression* rightChild
             );
         private:
             
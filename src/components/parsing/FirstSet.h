@@ -0,0 +1,63 @@
+#ifndef PARSING_FIRST_SET_HH
+#define PARSING_FIRST_SET_HH
+
+#include "../tokenization/DToken.h"
+#include "SymbolSet.h"
+
+namespace Parsing {
+    /**
+     * The tokens an expression of a parser can start with, by kind or by value, and 
+     * whether the parser can succeed without consuming any token. A parser that can 
+     * succeed on nothing admits any token, since what follows is up to the parsers after it.
+     */
+    class FirstSet {
+        public:
+            FirstSet(): _nullable(false) {}
+
+            /**
+             * The first set of a parser that nothing is known of, which admits every token.
+             */
+            static FirstSet any() {
+                auto firstSet = FirstSet{};
+                firstSet.setNullable(true);
+                return firstSet;
+            }
+
+            void insert(int symbol) {
+                this->_symbols.insert(symbol);
+            }
+
+            void insert(const SymbolSet& symbols) {
+                this->_symbols.insert(symbols);
+            }
+
+            /**
+             * Adds the tokens of the other set, and its nullability, returning whether anything changed.
+             */
+            bool insert(const FirstSet& other) {
+                bool changed = this->_symbols.insert(other._symbols);
+                if (other._nullable && !this->_nullable) {
+                    this->_nullable = true;
+                    changed = true;
+                }
+                return changed;
+            }
+
+            bool nullable() const {
+                return this->_nullable;
+            }
+
+            void setNullable(bool nullable) {
+                this->_nullable = nullable;
+            }
+
+            bool admits(const DToken& token) const {
+                return this->_nullable || this->_symbols.contains(token.kind) || this->_symbols.contains(token.symbol);
+            }
+        private:
+            SymbolSet _symbols;
+            bool _nullable;
+    };
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "GrammarAnalysis.h"
+#include "IParseable.h"
+
+void Parsing::GrammarAnalysis::analyze(IParseable& root)
+{
+    auto analysis = GrammarAnalysis{};
+    analysis._index(&root);
+    analysis._changed = true;
+    while (analysis._changed) {
+        analysis._changed = false;
+        // Parsers found during a round are analyzed in the same round.
+        for (int i = 0; i < (int) analysis._parsers.size(); i++) {
+            auto firstSet = analysis._parsers[i]->firstSet(analysis);
+            analysis._changed = analysis._firstSets[i].insert(firstSet) || analysis._changed;
+        }
+    }
+    for (int i = 0; i < (int) analysis._parsers.size(); i++) {
+        analysis._parsers[i]->setFirstSet(analysis._firstSets[i]);
+    }
+}
+
+Parsing::FirstSet Parsing::GrammarAnalysis::firstSet(IParseable* parser)
+{
+    return this->_firstSets[this->_index(parser)];
+}
+
+void Parsing::GrammarAnalysis::include(IParseable* parser, const FirstSet& firstSet)
+{
+    this->_changed = this->_firstSets[this->_index(parser)].insert(firstSet) || this->_changed;
+}
+
+Parsing::GrammarAnalysis::GrammarAnalysis():
+    _changed(false) {
+
+}
+
+int Parsing::GrammarAnalysis::_index(IParseable* parser)
+{
+    auto [entry, isNew] = this->_indices.try_emplace(parser, (int) this->_parsers.size());
+    if (isNew) {
+        this->_parsers.push_back(parser);
+        this->_firstSets.push_back(FirstSet{});
+    }
+    return entry->second;
+}
@@ -0,0 +1,41 @@
+#ifndef PARSING_GRAMMAR_ANALYSIS_HH
+#define PARSING_GRAMMAR_ANALYSIS_HH
+
+#include <unordered_map>
+#include <vector>
+#include "FirstSet.h"
+
+class IParseable;
+
+namespace Parsing {
+    /**
+     * Computes the first sets of all parsers of a grammar. Grammars are recursive, so 
+     * the sets are computed by repeatedly letting every parser derive its set from 
+     * those of its sub-parsers found so far, until none of them grows any more.
+     */
+    class GrammarAnalysis {
+        public:
+            /**
+             * Analyzes the parsers reachable from the given one and hands each of them its first set.
+             */
+            static void analyze(IParseable& root);
+            /**
+             * The first set found so far for the parser, which becomes part of the analysis if it is new to it.
+             */
+            FirstSet firstSet(IParseable* parser);
+            /**
+             * Adds tokens to the first set of a parser, for rules that parsers 
+             * only give to other parsers while parsing.
+             */
+            void include(IParseable* parser, const FirstSet& firstSet);
+        private:
+            GrammarAnalysis();
+            std::vector<IParseable*> _parsers;
+            std::unordered_map<IParseable*, int> _indices;
+            std::vector<FirstSet> _firstSets;
+            bool _changed;
+            int _index(IParseable* parser);
+    };
+};
+
+#endif
@@ -3,24 +3,109 @@
 
 #include <utility>
 #include <memory>
+#include <stdexcept>
 #include "../tokenization/DToken.h"
 #include "Expression.h"
+#include "ParseResult.h"
+#include "ParseSession.h"
+#include "FirstSet.h"
+#include "TokenSequence.h"
 #include <iostream>
 
+namespace Parsing {
+    class GrammarAnalysis;
+};
+
 class IParseable {
     public:
-        virtual std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position) = 0;
+        /**
+         * Parses an expression starting at the given position. A mismatch is returned 
+         * as a failed result instead of being thrown, so that callers can cheaply try 
+         * other alternatives. Within a memoizing ParseSession, the result is looked up 
+         * from the memo table of the session if the parser was already tried here. 
+         * A result the session has prepared ahead of time is used instead of parsing.
+         */
+        Parsing::ParseResult tryParse(std::vector<DToken>& tokens, int position) {
+            auto session = Parsing::ParseSession::current();
+            if (session == nullptr) {
+                return this->_tryParse(tokens, position);
+            }
+            if (session->hasPreparedResults()) {
+                auto prepared = session->takePreparedResult(this, position);
+                if (prepared.has_value()) {
+                    return *prepared;
+                }
+            }
+            if (!session->memoizes()) {
+                return this->_tryParse(tokens, position);
+            }
+            auto memoized = session->findResult(this, position);
+            if (memoized.has_value()) {
+                return *memoized;
+            }
+            auto result = this->_tryParse(tokens, position);
+            session->storeResult(this, position, result);
+            return result;
+        }
+        /**
+         * Parses an expression starting at the given position, throwing
+         * a std::runtime_error describing the failure if there is none.
+         */
+        Expression* parse(std::vector<DToken>& tokens, int position) {
+            auto result = this->tryParse(tokens, position);
+            if (!result.succeeded()) {
+                throw std::runtime_error(result.message(tokens));
+            }
+            return result.expression();
+        }
+        /**
+         * Whether the parser can start parsing at the given position. Once the grammar 
+         * of the parser has been analyzed, this only looks at the token there, so a 
+         * parse may still fail later on. Otherwise, it parses to find out.
+         */
         virtual bool canParseAt(std::vector<DToken>& tokens, int position) {
-            try {
-                this->parse(tokens, position);
-                return true;
-            } /* catch (std::exception& e) {
-                std::cout << e.what() << std::endl;
-                return false;
-            } */ catch (...) {
-                return false;
+            if (this->_analyzed) {
+                auto sequence = TokenSequence{tokens};
+                sequence.setPosition(position);
+                return this->_firstSet.admits(sequence.peek());
             }
+            return this->tryParse(tokens, position).succeeded();
+        }
+        /**
+         * Whether an expression of the parser may start with the token. Without 
+         * an analysis of the grammar, the parser may start with any token.
+         */
+        bool admits(const DToken& token) {
+            return !this->_analyzed || this->_firstSet.admits(token);
+        }
+        /**
+         * Whether the parser takes on parsing at the given position by looking at
+         * the tokens there, so that if it then fails, the failure is an error instead
+         * of a sign to try something else. By default, parsers do not, and their
+         * failures only tell that nothing could be parsed.
+         */
+        virtual bool commitsAt(std::vector<DToken>& tokens, int position) {
+            return false;
+        }
+        /**
+         * Derives the first set of the parser from the first sets of its sub-parsers in 
+         * the analysis. By default nothing is known of the parser, so it admits any token.
+         */
+        virtual Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis) {
+            return Parsing::FirstSet::any();
+        }
+        void setFirstSet(Parsing::FirstSet firstSet) {
+            this->_firstSet = firstSet;
+            this->_analyzed = true;
         }
+    protected:
+        /**
+         * Parses an expression starting at the given position without consulting any memo table.
+         */
+        virtual Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position) = 0;
+    private:
+        Parsing::FirstSet _firstSet;
+        bool _analyzed = false;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,4 +1,5 @@
 #include "ListParser.h"
+#include "GrammarAnalysis.h"
 
 Parsing::ListParser::ListParser(
     std::string type,
@@ -13,8 +14,8 @@ Parsing::ListParser::ListParser(
             type,
             separator,
             elementParser,
-            [endCharacter](std::vector<DToken>& tokens, int position) {
-                return tokens.at(position).value == endCharacter;
+            [endSymbol = Tokenization::Symbols::id(endCharacter)](std::vector<DToken>& tokens, int position) {
+                return tokens.at(position).symbol == endSymbol;
             }
         }
     );
@@ -24,10 +25,19 @@ Parsing::ListParser::ListParser(
     );
 }
 
-std::shared_ptr<Expression> Parsing::ListParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult Parsing::ListParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	auto expression = this->_parentheticalParser->parse(tokens, position)->children().at(0);
+    auto parseResult = this->_parentheticalParser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+	auto expression = Expression::copy(parseResult.expression()->children().at(0));
     // Skip past the end character.
     expression->setEndPos(expression->endPos() + 1);
     return expression;
 }
+
+Parsing::FirstSet Parsing::ListParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_parentheticalParser.get());
+}
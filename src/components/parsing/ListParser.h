@@ -25,7 +25,9 @@ namespace Parsing {
                 std::string separator, 
                 IParseable& elementParser
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             IParseable& _elementParser;
             std::unique_ptr<Parsing::ParentheticalParser> _parentheticalParser;
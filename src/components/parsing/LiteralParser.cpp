@@ -1,33 +1,37 @@
 #include "LiteralParser.h"
+#include "GrammarAnalysis.h"
 
 LiteralParser::LiteralParser(
-        std::string type
+        std::string type,
+        std::string attribute
     ):
-    _type(type) {
+    _type(type), _attribute(attribute), _kind(Tokenization::Symbols::id(type)) {
     
 }
 
-std::shared_ptr<Expression> LiteralParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult LiteralParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
     auto tokenSequence = TokenSequence{tokens};
     tokenSequence.setPosition(position);
-    auto nextToken = tokenSequence.consume();
+    auto& nextToken = tokenSequence.consume();
     
-    if (nextToken.type == this->_type) {
-        auto expression = std::shared_ptr<Expression>(
-            new Expression{
-                this->_type,
-                position,
-                position + 1
-            }
+    if (nextToken.kind == this->_kind) {
+        auto expression = Expression::create(
+            this->_type,
+            position,
+            position + 1
         );
-        expression->tokens().insert(expression->tokens().end(), nextToken);
-        expression->subTypes().insert({"name", nextToken.value});
+        Expression::addToken(expression, nextToken);
+        expression->subTypes().insert({this->_attribute, std::string{nextToken.value()}});
         return expression;
     } else {
-        throw std::runtime_error(
-            "Expected a literal expression of type '" + this->_type + "' at " + 
-            nextToken.startLocation.toString()
-        );
+        return Parsing::ParseResult::failure(Parsing::ParseResult::missingLiteral, position, &this->_type);
     }
+}
+
+Parsing::FirstSet LiteralParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    auto firstSet = Parsing::FirstSet{};
+    firstSet.insert(this->_kind);
+    return firstSet;
 }
\ No newline at end of file
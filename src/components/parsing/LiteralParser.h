@@ -10,16 +10,22 @@
 
 /**
  * A literal expression, i.e. an expression that does not consist 
- * of sub-expressions.
+ * of sub-expressions. The text of the literal is given to the expression 
+ * as the given attribute, which is its name unless told otherwise.
  */
 class LiteralParser: public IParseable {
     public:
         LiteralParser(
-            std::string type
+            std::string type,
+            std::string attribute = "name"
         );
-        std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+        Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+    protected:
+        Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
     private:
         std::string _type;
+        std::string _attribute;
+        int _kind;
 };
 
 #endif
\ No newline at end of file
@@ -1,59 +1,112 @@
 #include "MapParser.h"
+#include "GrammarAnalysis.h"
 #include <iostream>
 
 MapParser::MapParser() {
     
 }
 
-std::shared_ptr<Expression> MapParser::parse(std::vector<DToken>& tokens, int position) {
+Parsing::ParseResult MapParser::_tryParse(std::vector<DToken>& tokens, int position) {
     auto tokenSequence = TokenSequence{tokens};
     tokenSequence.setPosition(position);
-    auto token = tokenSequence.peek();
+    auto& token = tokenSequence.peek();
 
-    if (this->_parsers.contains(token.type)) {
-        return this->parseWith(tokens, token.type, position);
-    } else if (this->_parsers.contains(token.value)) {
-        return this->parseWith(tokens, token.value, position);
+    auto parser = this->_parserFor(token);
+    if (parser != nullptr) {
+        return parser->tryParse(tokens, position);
     } else if (this->_wildCardParser != nullptr) {
         // Parse using a wildcard parsing rule.
-        return this->_wildCardParser->parse(tokens, position);
+        return this->_wildCardParser->tryParse(tokens, position);
     } else {
-        throw std::runtime_error(
-            "Unexpected token '" + token.value + "' found at " +
-            token.startLocation.toString()
-        );
+        return Parsing::ParseResult::failure(Parsing::ParseResult::unexpectedToken, position);
     }
 }
 
-std::shared_ptr<Expression> MapParser::parseWith(std::vector<DToken>& tokens, std::string rule, int position) {
+Parsing::ParseResult MapParser::parseWith(std::vector<DToken>& tokens, std::string rule, int position) {
     auto parser = this->_parsers.at(rule);
-    return parser->parse(tokens, position);
+    return parser->tryParse(tokens, position);
 }
 
-bool MapParser::canParseAt(std::vector<DToken>& tokens, int position)
+bool MapParser::commitsAt(std::vector<DToken>& tokens, int position)
 {
     auto sequence = TokenSequence{tokens};
     sequence.setPosition(position);
-    auto token = sequence.peek();
 
-    if (this->_parsers.contains(token.type) || this->_parsers.contains(token.value)) {
+    if (this->_parserFor(sequence.peek()) != nullptr) {
         return true;
     } else if (this->_wildCardParser != nullptr) {
-        return this->_wildCardParser->canParseAt(tokens, position);
+        return this->_wildCardParser->commitsAt(tokens, position);
     } else {
         return false;
     }
 }
 
-std::map<std::string, IParseable*>& MapParser::parsers() {
+const std::map<std::string, IParseable*>& MapParser::parsers() {
     return this->_parsers;
 }
 
 void MapParser::setParsers(std::map<std::string, IParseable*> parsers) {
-    this->_parsers = parsers;
+    this->_parsers = std::map<std::string, IParseable*>{};
+    this->_parserTable.clear();
+    for (auto& [rule, parser] : parsers) {
+        this->setParser(rule, parser);
+    }
+}
+
+void MapParser::setParser(std::string rule, IParseable* parser) {
+    this->_parsers[rule] = parser;
+    this->_parserTable.set(Tokenization::Symbols::id(rule), parser);
+}
+
+void MapParser::removeParser(std::string rule) {
+    this->_parsers.erase(rule);
+    this->_parserTable.set(Tokenization::Symbols::id(rule), nullptr);
+}
+
+void MapParser::setContextualParser(std::string rule, IParseable* parser, int context) {
+    this->_contextualParsers[rule] = DContextualRule{parser, context};
+    this->_contextualParserTable.set(Tokenization::Symbols::id(rule), DContextualRule{parser, context});
 }
 
 void MapParser::setWildCardParser(IParseable* wildCardParser)
 {
     this->_wildCardParser = wildCardParser;
-}
\ No newline at end of file
+}
+
+IParseable* MapParser::_parserFor(const DToken& token) {
+    auto parser = this->_parserTable.at(token.kind);
+    if (parser == nullptr) {
+        parser = this->_parserTable.at(token.symbol);
+    }
+    if (parser == nullptr && !this->_contextualParsers.empty()) {
+        auto rule = this->_contextualParserTable.at(token.kind);
+        if (rule.parser == nullptr) {
+            rule = this->_contextualParserTable.at(token.symbol);
+        }
+        auto session = Parsing::ParseSession::current();
+        int context = session != nullptr ? session->context() : 0;
+        if (rule.parser != nullptr && (context & rule.context) == rule.context) {
+            parser = rule.parser;
+        }
+    }
+    return parser;
+}
+
+Parsing::FirstSet MapParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    // The rule of a token is taken on whether or not its parser then succeeds.
+    auto firstSet = Parsing::FirstSet{};
+    for (auto& [rule, parser] : this->_parsers) {
+        firstSet.insert(Tokenization::Symbols::id(rule));
+        analysis.firstSet(parser);
+    }
+    // Contextual rules may be in effect whenever the parser is used.
+    for (auto& [rule, contextualRule] : this->_contextualParsers) {
+        firstSet.insert(Tokenization::Symbols::id(rule));
+        analysis.firstSet(contextualRule.parser);
+    }
+    if (this->_wildCardParser != nullptr) {
+        firstSet.insert(analysis.firstSet(this->_wildCardParser));
+    }
+    return firstSet;
+}
@@ -10,23 +10,53 @@
 #include "../tokenization/DToken.h"
 #include "TokenSequence.h"
 #include "TExpressions.h"
+#include "SymbolMap.h"
 
 /**
  * An expression that can be one of several expression 
- * types depending on what the next token is.
+ * types depending on what the next token is. A parsing rule 
+ * is chosen by the kind of the next token or, failing that, by its 
+ * value. Values can only be matched if they are fixed spellings of 
+ * some token pattern, such as keywords or operators.
  */
 class MapParser: public IParseable {
     public:
         MapParser();
-        std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
-        std::shared_ptr<Expression> parseWith(std::vector<DToken>& tokens, std::string rule, int position);
-        bool canParseAt(std::vector<DToken>& tokens, int position);
-        std::map<std::string, IParseable*>& parsers();
+        Parsing::ParseResult parseWith(std::vector<DToken>& tokens, std::string rule, int position);
+        /**
+         * A map parser takes on the tokens it has a rule for, and otherwise 
+         * whatever its wildcard parser takes on.
+         */
+        bool commitsAt(std::vector<DToken>& tokens, int position);
+        const std::map<std::string, IParseable*>& parsers();
         void setParsers(std::map<std::string, IParseable*> parsers);
+        void setParser(std::string rule, IParseable* parser);
+        void removeParser(std::string rule);
+        /**
+         * Sets a rule that is only in effect while the context of the current ParseSession 
+         * has all the bits of the given context set. Rules set without a context take 
+         * precedence. Other parsers turn such rules on and off by changing the context of 
+         * the session, so that the rules of the parser itself never change while parsing.
+         */
+        void setContextualParser(std::string rule, IParseable* parser, int context);
         void setWildCardParser(IParseable* wildCardParser);
+        Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+    protected:
+        Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
     private:
         std::map<std::string, IParseable*> _parsers = std::map<std::string, IParseable*>();
+        /**
+         * The parsers indexed by the symbols of their rules.
+         */
+        Parsing::SymbolMap<IParseable*> _parserTable = Parsing::SymbolMap<IParseable*>(nullptr);
         IParseable* _wildCardParser = nullptr;
+        struct DContextualRule {
+            IParseable* parser;
+            int context;
+        };
+        std::map<std::string, DContextualRule> _contextualParsers = std::map<std::string, DContextualRule>();
+        Parsing::SymbolMap<DContextualRule> _contextualParserTable = Parsing::SymbolMap<DContextualRule>(DContextualRule{nullptr, 0});
+        IParseable* _parserFor(const DToken& token);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,56 @@
+#include "Names.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // Names are kept in a deque so that references to them stay valid as names are added, 
+    // and the ids are looked up by views of the names in the deque, so each name is stored once.
+    struct DNameTable {
+        std::mutex mutex;
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, int> ids;
+    };
+
+    DNameTable& nameTable() {
+        static DNameTable table;
+        return table;
+    }
+
+    // Each thread remembers the names it has looked up, by the same views into the table, 
+    // so that threads creating expressions at the same time do not wait for each other on it.
+    thread_local std::unordered_map<std::string_view, int> knownIds;
+    thread_local std::vector<const std::string*> knownNames;
+}
+
+int Parsing::Names::id(std::string_view name) {
+    auto known = knownIds.find(name);
+    if (known != knownIds.end()) {
+        return known->second;
+    }
+    auto& table = nameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto existing = table.ids.find(name);
+    if (existing == table.ids.end()) {
+        int id = (int) table.names.size();
+        table.names.emplace_back(name);
+        existing = table.ids.emplace(std::string_view{table.names.back()}, id).first;
+    }
+    knownIds.emplace(existing->first, existing->second);
+    return existing->second;
+}
+
+const std::string& Parsing::Names::name(int id) {
+    if (id >= 0 && id < (int) knownNames.size() && knownNames[id] != nullptr) {
+        return *knownNames[id];
+    }
+    auto& table = nameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto& name = table.names.at(id);
+    if (id >= (int) knownNames.size()) {
+        knownNames.resize(id + 1, nullptr);
+    }
+    knownNames[id] = &name;
+    return name;
+}
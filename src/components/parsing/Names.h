@@ -0,0 +1,31 @@
+#ifndef PARSING_NAMES_HH
+#define PARSING_NAMES_HH
+
+#include <string>
+#include <string_view>
+
+namespace Parsing {
+    /**
+     * Interns the kinds of expressions and the names in their attributes, such as 
+     * names of variables and types, into integer ids shared by the whole program. 
+     * Expressions store the ids only, so that two expressions with the same name 
+     * share one copy of it and names can be compared with integer comparisons.
+     *
+     * Interned names are never released, so only names drawn from a limited vocabulary 
+     * are interned. Values like those of literals are kept in expression arenas instead.
+     */
+    class Names {
+        public:
+            /**
+             * The id of no name at all.
+             */
+            static constexpr int none = -1;
+            /**
+             * Returns the id of the given name, adding the name if it is new.
+             */
+            static int id(std::string_view name);
+            static const std::string& name(int id);
+    };
+};
+
+#endif
@@ -1,70 +1,73 @@
 #include "OperatedChainParser.h"
+#include "GrammarAnalysis.h"
 #include "TokenSequence.h"
 #include <iostream>
+#include <limits>
 
 OperatedChainParser::OperatedChainParser(
         IParseable& parser,
-        std::map<std::string, IParseable*> nonUnaryParsers,
+        std::map<std::string, BinaryParser*> nonUnaryParsers,
         std::map<std::string, int> precedenceLevels
     ):
     _parser(parser),
     _nonUnaryParsers(nonUnaryParsers),
     _precedenceLevels(precedenceLevels) {
-    
+    for (auto& [kind, nonUnaryParser] : nonUnaryParsers) {
+        this->_nonUnaryParserTable.set(Tokenization::Symbols::id(kind), nonUnaryParser);
+    }
+    this->setPrecedenceLevels(precedenceLevels);
 }
 
-std::shared_ptr<Expression> OperatedChainParser::parse(std::vector<DToken>& tokens, int position) {
+Parsing::ParseResult OperatedChainParser::_tryParse(std::vector<DToken>& tokens, int position) {
     auto tokenSequence = TokenSequence{tokens};
-    tokenSequence.setPosition(position);
+    return this->_parseOperations(tokens, tokenSequence, position, std::numeric_limits<int>::min());
+}
 
+Parsing::ParseResult OperatedChainParser::_parseOperations(
+    std::vector<DToken>& tokens, 
+    TokenSequence& tokenSequence, 
+    int position, 
+    int lowestPrecedence
+) {
     // First encountered expression.
-    auto firstExpression = this->_parser.parse(tokens, position);
-    tokenSequence.setPosition(firstExpression->endPos());
-
-    // The next token past the first expression.
-    auto nextToken = tokenSequence.consume();
-
-    // If the next token is a recognized non-unary operator.
-    if (this->_nonUnaryParsers.contains(nextToken.type)) {
-        // The non-unary expression is parsed starting from the start of the first expression 
-        // because the first expression becomes the non-unary expression's child.
-        auto nonUnaryExpression = this->_nonUnaryParsers.at(nextToken.type)->parse(tokens, position);
-        tokenSequence.setPosition(nonUnaryExpression->endPos());
-
-        // If a further non-unary operator is encountered.
-        if (this->_nonUnaryParsers.contains(tokenSequence.peek().type)) {
-            auto rightMostChild = (Expression) (*(*(nonUnaryExpression->children().end() - 1)));
-            auto restExpression = this->parse(tokens, rightMostChild.startPos());
-
-            // Find the first leftmost descendant of the rest of the expression chain 
-            // that has a higher precedence level than the non-unary expression.
-            auto highestLeftChild = this->_firstHigherPrecedenceLeftChild(
-                restExpression, 
-                this->precedenceLevel(nonUnaryExpression)
-            );
-
-            // Remove the right-most child of the non-unary expression since 
-            // we will replace it with some possibly other expression from the 
-            // rest of the expression chain.
-            nonUnaryExpression->children().erase(nonUnaryExpression->children().end() - 1);
-
-            // Make the non-unary expression take the place of the found left descendant,
-            // adding the descendant as its child.
-            Expression::replaceAsParent(nonUnaryExpression, highestLeftChild);
+    auto firstResult = this->_parser.tryParse(tokens, position);
+    if (!firstResult.succeeded()) {
+        return firstResult;
+    }
+    auto expression = firstResult.expression();
+
+    while (true) {
+        // The next token past the expression parsed so far.
+        tokenSequence.setPosition(expression->endPos());
+        auto& operatorToken = tokenSequence.consume();
+
+        // Stop at anything other than a recognized non-unary operator, or at an 
+        // operator that binds more loosely than the operator we are the right operand of.
+        auto nonUnaryParser = this->_nonUnaryParserTable.at(operatorToken.kind);
+        if (nonUnaryParser == nullptr) {
+            break;
+        }
+        int precedence = this->_precedenceLevelTable.at(operatorToken.symbol);
+        if (precedence < lowestPrecedence) {
+            break;
+        }
 
-            // Return the root node of the parse tree fragment.
-            return Expression::earliestAncestor(nonUnaryExpression);
-        } else {
-            // We return the single non-unary expression encountered.
-            return nonUnaryExpression;
+        // The right operand spans the following operators of a higher precedence level. 
+        // The recursion is at most as deep as there are precedence levels.
+        auto secondResult = this->_parseOperations(tokens, tokenSequence, tokenSequence.position(), precedence + 1);
+        if (!secondResult.succeeded()) {
+            return secondResult;
         }
-    } else {
-        // We return the first expression.
-        return firstExpression;
+        auto nonUnaryResult = nonUnaryParser->combine(expression, operatorToken, secondResult.expression());
+        if (!nonUnaryResult.succeeded()) {
+            return nonUnaryResult;
+        }
+        expression = nonUnaryResult.expression();
     }
+    return expression;
 }
 
-int OperatedChainParser::precedenceLevel(std::shared_ptr<Expression> expression)
+int OperatedChainParser::precedenceLevel(Expression* expression)
 {
     // Get the precedence level of the expression type.
     // The expression has by default the lowest precedence level 
@@ -73,36 +76,20 @@ int OperatedChainParser::precedenceLevel(std::shared_ptr<Expression> expression)
     if (this->_precedenceLevels.contains(expression->type())) {
         precedenceLevel = this->_precedenceLevels.at(expression->type());
         
-    } else if (this->_precedenceLevels.contains(expression->rootToken().value)) {
-        precedenceLevel = this->_precedenceLevels.at(expression->rootToken().value);
+    } else {
+        precedenceLevel = this->_precedenceLevelTable.at(expression->rootToken().symbol);
     }
 
     return precedenceLevel;
 }
 
-std::shared_ptr<Expression> OperatedChainParser::_firstHigherPrecedenceLeftChild(std::shared_ptr<Expression> expression, int precedence)
-{
-    // If the precedence level is higher than the one we are comparing against.
-    if (this->precedenceLevel(expression) > precedence) {
-        // Then we have found the leftmost child that has a higher precedence level.
-        return expression;
-    } else {
-        // Else, the precedence level is lower than or equal.
-        // If the expression has a left child then we recurse over that.
-        if (expression->children().size() > 0) {
-            return this->_firstHigherPrecedenceLeftChild(expression->children().at(0), precedence);
-        } else {
-            // Otherwise, we have reached the left-most child, which must be a literal expression 
-            // since it has no children. Since it is a literal expression we assume it to have 
-            // the highest possible precedence. Thus, we return it.
-            return expression;
-        }
-    }
-}
-
 void OperatedChainParser::setPrecedenceLevels(std::map<std::string, int> precedenceLevels)
 {
     this->_precedenceLevels = precedenceLevels;
+    this->_precedenceLevelTable.clear();
+    for (auto& [name, level] : precedenceLevels) {
+        this->_precedenceLevelTable.set(Tokenization::Symbols::id(name), level);
+    }
 }
 
 IParseable& OperatedChainParser::parser()
@@ -110,7 +97,7 @@ IParseable& OperatedChainParser::parser()
     return this->_parser;
 }
 
-std::map<std::string, IParseable*> OperatedChainParser::nonUnaryParsers()
+std::map<std::string, BinaryParser*> OperatedChainParser::nonUnaryParsers()
 {
     return this->_nonUnaryParsers;
 }
@@ -119,3 +106,11 @@ std::map<std::string, int> OperatedChainParser::precedenceLevels()
 {
     return this->_precedenceLevels;
 }
+
+Parsing::FirstSet OperatedChainParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    for (auto& [kind, nonUnaryParser] : this->_nonUnaryParsers) {
+        analysis.firstSet(nonUnaryParser);
+    }
+    return analysis.firstSet(&this->_parser);
+}
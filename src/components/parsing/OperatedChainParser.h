@@ -8,32 +8,55 @@
 #include "TokenSequence.h"
 #include "IParseable.h"
 #include "MapParser.h"
+#include "BinaryParser.h"
 #include <set>
+#include "SymbolMap.h"
 
 /**
  * A parser for an expression that consists of 
  * consecutive (possibly recursive) sub-expressions.
  * These sub-expressions may have unary operators in front of them 
  * or they may be joined via binary operators.
+ *
+ * The chain is parsed by precedence climbing in a single pass from left to right: 
+ * each operand is parsed once, and an operator takes as its right operand everything 
+ * up to the next operator of the same or lower precedence level. Operators of the same 
+ * level associate to the left.
  */
 class OperatedChainParser: public IParseable {
     public:
         OperatedChainParser(
             IParseable& parser,
-            std::map<std::string, IParseable*> nonUnaryParsers,
+            std::map<std::string, BinaryParser*> nonUnaryParsers,
             std::map<std::string, int> precedenceLevels = std::map<std::string, int>()
         );
-        std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
-        int precedenceLevel(std::shared_ptr<Expression> expression);
+        int precedenceLevel(Expression* expression);
         void setPrecedenceLevels(std::map<std::string, int> precedenceLevels);
         IParseable& parser();
-        std::map<std::string, IParseable*> nonUnaryParsers();
+        std::map<std::string, BinaryParser*> nonUnaryParsers();
         std::map<std::string, int> precedenceLevels();
+        Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+    protected:
+        Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
     private:
         IParseable& _parser;
-        std::map<std::string, IParseable*> _nonUnaryParsers;
+        std::map<std::string, BinaryParser*> _nonUnaryParsers;
         std::map<std::string, int> _precedenceLevels;
-        std::shared_ptr<Expression> _firstHigherPrecedenceLeftChild(std::shared_ptr<Expression> expression, int precedence);
+        /**
+         * The non-unary parsers indexed by token kind and the precedence 
+         * levels indexed by token value symbol.
+         */
+        Parsing::SymbolMap<BinaryParser*> _nonUnaryParserTable = Parsing::SymbolMap<BinaryParser*>(nullptr);
+        Parsing::SymbolMap<int> _precedenceLevelTable = Parsing::SymbolMap<int>(-1);
+        /**
+         * Parses operands joined by operators of at least the given precedence level.
+         */
+        Parsing::ParseResult _parseOperations(
+            std::vector<DToken>& tokens, 
+            TokenSequence& tokenSequence, 
+            int position, 
+            int lowestPrecedence
+        );
 };
 
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "ParentheticalParser.h"
+#include "GrammarAnalysis.h"
 #include "TokenSequence.h"
 #include <iostream>
 
@@ -8,49 +9,59 @@ Parsing::ParentheticalParser::ParentheticalParser(
     std::string endCharacter, 
     IParseable& parser
 ):
-    _type(type), _beginCharacter(beginCharacter), _endCharacter(endCharacter), _parser(parser), _stripParentheses(false) {
+    _type(type), 
+    _beginCharacter(beginCharacter), 
+    _endCharacter(endCharacter), 
+    _beginSymbol(Tokenization::Symbols::id(beginCharacter)),
+    _endSymbol(Tokenization::Symbols::id(endCharacter)),
+    _parser(parser), 
+    _stripParentheses(false) {
 }
 
-std::shared_ptr<Expression> Parsing::ParentheticalParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult Parsing::ParentheticalParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
     auto sequence = TokenSequence{tokens};
     sequence.setPosition(position);
     
-    auto beginToken = sequence.consume();
+    auto& beginToken = sequence.consume();
 
-    if (beginToken.value == this->_beginCharacter) {
-        auto expression = this->_parser.parse(tokens, sequence.position());
+    if (beginToken.symbol == this->_beginSymbol) {
+        auto parseResult = this->_parser.tryParse(tokens, sequence.position());
+        if (!parseResult.succeeded()) {
+            return parseResult;
+        }
+        auto& expression = parseResult.expression();
         sequence.setPosition(expression->endPos());
 
-        auto endToken = sequence.consume();
+        auto& endToken = sequence.consume();
 
-        if (endToken.value == this->_endCharacter) {
+        if (endToken.symbol == this->_endSymbol) {
             if (!this->_stripParentheses) {
-                auto result = std::shared_ptr<Expression>(
-                    new Expression{this->_type, position, sequence.position()}
-                );
-                result->tokens().insert(result->tokens().end(), beginToken);
-                result->tokens().insert(result->tokens().end(), endToken);
-                result->children().insert(result->children().end(), expression);
+                auto result = Expression::create(this->_type, position, sequence.position());
+                Expression::addToken(result, beginToken);
+                Expression::addToken(result, endToken);
+                result->setChildren({expression});
                 return result;
             } else {
                 return expression;
             }
         } else {
-            throw std::runtime_error(
-                "Expected a '" + this->_endCharacter + "' but instead encountered '" + 
-                endToken.value + "' at " + endToken.startLocation.toString()
-            );
+            return ParseResult::failure(ParseResult::missingDelimiter, sequence.position() - 1, &this->_endCharacter);
         }
     } else {
-        throw std::runtime_error(
-            "Expected a '" + this->_beginCharacter + "' but instead encountered '" + 
-            beginToken.value + "' at " + beginToken.startLocation.toString()
-        );
+        return ParseResult::failure(ParseResult::missingDelimiter, position, &this->_beginCharacter);
     }
 }
 
 void Parsing::ParentheticalParser::setStripParentheses(bool stripParentheses)
 {
     this->_stripParentheses = stripParentheses;
+}
+
+Parsing::FirstSet Parsing::ParentheticalParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    auto firstSet = Parsing::FirstSet{};
+    firstSet.insert(this->_beginSymbol);
+    analysis.firstSet(&this->_parser);
+    return firstSet;
 }
\ No newline at end of file
@@ -7,15 +7,19 @@ namespace Parsing {
     class ParentheticalParser: public IParseable {
         public:
             ParentheticalParser(std::string type, std::string beginCharacter, std::string endCharacter, IParseable& parser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
             /**
              * Set whether to wrap the result expression in a parenthetical expression or not. Default is false.
              */
             void setStripParentheses(bool stripParentheses);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::string _type;
             std::string _beginCharacter;
             std::string _endCharacter;
+            int _beginSymbol;
+            int _endSymbol;
             IParseable& _parser;
             bool _stripParentheses;
     };
@@ -0,0 +1,75 @@
+#include "ParseResult.h"
+#include "TokenSequence.h"
+
+Parsing::ParseResult::ParseResult():
+    _expression(nullptr), _reason(0), _position(-1), _expected(nullptr) {
+
+}
+
+Parsing::ParseResult::ParseResult(Expression* expression):
+    _expression(std::move(expression)), _reason(0), _position(-1), _expected(nullptr) {
+
+}
+
+Parsing::ParseResult Parsing::ParseResult::failure(int reason, int position, const std::string* expected)
+{
+    auto result = ParseResult{};
+    result._reason = reason;
+    result._position = position;
+    result._expected = expected;
+    return result;
+}
+
+bool Parsing::ParseResult::succeeded() const
+{
+    return this->_expression != nullptr;
+}
+
+Expression*& Parsing::ParseResult::expression()
+{
+    return this->_expression;
+}
+
+int Parsing::ParseResult::reason() const
+{
+    return this->_reason;
+}
+
+int Parsing::ParseResult::position() const
+{
+    return this->_position;
+}
+
+std::string Parsing::ParseResult::message(std::vector<DToken>& tokens) const
+{
+    auto sequence = TokenSequence{tokens};
+    sequence.setPosition(this->_position);
+    auto& token = sequence.peek();
+    auto value = std::string{token.value()};
+    auto expected = this->_expected != nullptr ? *(this->_expected) : std::string{};
+    auto location = token.startLocation().toString();
+
+    switch (this->_reason) {
+        case unexpectedToken:
+            return "Unexpected token '" + value + "' found at " + location;
+        case unexpectedElement:
+            return "Unexpected token '" + expected + "' encountered at " + location;
+        case missingSeparator:
+            return (
+                "Expected a separator character '" + expected + "' to follow but '" +
+                value + "' was encountered instead at " + location
+            );
+        case noMatchingRule:
+            return "No parsing rule could be matched at " + location;
+        case missingBinaryOperator:
+            return "Expected the binary operator: " + expected + " at " + location;
+        case missingUnaryOperator:
+            return "Expected the operator '" + expected + "' at " + location;
+        case missingLiteral:
+            return "Expected a literal expression of type '" + expected + "' at " + location;
+        case missingDelimiter:
+            return "Expected a '" + expected + "' but instead encountered '" + value + "' at " + location;
+        default:
+            return "Parsing failed at " + location;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef PARSING_PARSE_RESULT_HH
+#define PARSING_PARSE_RESULT_HH
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../tokenization/DToken.h"
+#include "Expression.h"
+
+namespace Parsing {
+    /**
+     * The outcome of parsing at some position: either the parsed expression or 
+     * the reason nothing could be parsed there. A failure only records what went 
+     * wrong and at which token, so that trying out alternatives is cheap. The 
+     * message is only formatted if the failure ends up being reported.
+     */
+    class ParseResult {
+        public:
+            // The reasons parsing may fail.
+            static const int unexpectedToken = 1;
+            static const int unexpectedElement = 2;
+            static const int missingSeparator = 3;
+            static const int noMatchingRule = 4;
+            static const int missingBinaryOperator = 5;
+            static const int missingUnaryOperator = 6;
+            static const int missingLiteral = 7;
+            static const int missingDelimiter = 8;
+
+            ParseResult(Expression* expression);
+            /**
+             * A failure of the given kind at the given token position. The expected 
+             * text, such as a missing delimiter, has to outlive the result.
+             */
+            static ParseResult failure(int reason, int position, const std::string* expected = nullptr);
+            bool succeeded() const;
+            Expression*& expression();
+            int reason() const;
+            int position() const;
+            /**
+             * Describes the failure, looking up the offending token from the given tokens.
+             */
+            std::string message(std::vector<DToken>& tokens) const;
+        private:
+            ParseResult();
+            Expression* _expression;
+            int _reason;
+            int _position;
+            const std::string* _expected;
+    };
+};
+
+#endif
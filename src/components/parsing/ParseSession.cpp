@@ -0,0 +1,184 @@
+#include "ParseSession.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+    thread_local Parsing::ParseSession* currentSession = nullptr;
+
+    // The size of the memo table of a new session, a power of two.
+    const std::size_t initialSlots = 1024;
+}
+
+Parsing::ParseSession::ParseSession(bool memoize):
+    _memoize(memoize), 
+    _context(0), 
+    _offset(0), 
+    _slots(std::vector<DSlot>(initialSlots, DSlot{nullptr, 0, 0, 0, ParseResult::failure(0, -1)})), 
+    _usedSlots(0), 
+    _hits(0), 
+    _misses(0) {
+
+}
+
+Parsing::ParseSession::Scope::Scope(ParseSession& session):
+    _previous(currentSession) {
+    currentSession = &session;
+}
+
+Parsing::ParseSession::Scope::~Scope() {
+    currentSession = this->_previous;
+}
+
+Parsing::ParseSession* Parsing::ParseSession::current()
+{
+    return currentSession;
+}
+
+bool Parsing::ParseSession::memoizes()
+{
+    return this->_memoize;
+}
+
+std::optional<Parsing::ParseResult> Parsing::ParseSession::findResult(IParseable* parser, int position)
+{
+    auto& slot = this->_slot(parser, position);
+    if (slot.parser == nullptr) {
+        this->_misses = this->_misses + 1;
+        return std::nullopt;
+    }
+    this->_hits = this->_hits + 1;
+    return slot.result;
+}
+
+void Parsing::ParseSession::storeResult(IParseable* parser, int position, ParseResult& result)
+{
+    auto& slot = this->_slot(parser, position);
+    if (slot.parser == nullptr) {
+        this->_usedSlots = this->_usedSlots + 1;
+    }
+    slot = DSlot{parser, position, this->_context, this->_offset, result};
+    if (2 * this->_usedSlots > this->_slots.size()) {
+        this->_rebuild();
+    }
+}
+
+void Parsing::ParseSession::prepareResult(IParseable* parser, int position, ParseResult result)
+{
+    this->_preparedResults.insert_or_assign(std::make_tuple(parser, position, this->_context), result);
+}
+
+bool Parsing::ParseSession::hasPreparedResults()
+{
+    return !this->_preparedResults.empty();
+}
+
+std::optional<Parsing::ParseResult> Parsing::ParseSession::takePreparedResult(IParseable* parser, int position)
+{
+    auto prepared = this->_preparedResults.find(std::make_tuple(parser, position, this->_context));
+    if (prepared == this->_preparedResults.end()) {
+        return std::nullopt;
+    }
+    auto result = prepared->second;
+    this->_preparedResults.erase(prepared);
+    return result;
+}
+
+void Parsing::ParseSession::discardPreparedResults()
+{
+    this->_preparedResults.clear();
+}
+
+void Parsing::ParseSession::setOffset(int offset)
+{
+    this->_offset = offset;
+}
+
+int Parsing::ParseSession::offset()
+{
+    return this->_offset;
+}
+
+int Parsing::ParseSession::context()
+{
+    return this->_context;
+}
+
+void Parsing::ParseSession::setContext(int context)
+{
+    this->_context = context;
+}
+
+long long Parsing::ParseSession::hits()
+{
+    return this->_hits;
+}
+
+long long Parsing::ParseSession::misses()
+{
+    return this->_misses;
+}
+
+double Parsing::ParseSession::hitRate()
+{
+    auto lookups = this->_hits + this->_misses;
+    return lookups > 0 ? (double) this->_hits / lookups : 0;
+}
+
+std::size_t Parsing::ParseSession::memoEntries()
+{
+    return this->_usedSlots;
+}
+
+std::size_t Parsing::ParseSession::memoBytes()
+{
+    return this->_slots.size() * sizeof(DSlot);
+}
+
+Parsing::ParseSession::DSlot& Parsing::ParseSession::_slot(IParseable* parser, int position)
+{
+    // Linear probing from a multiplicative hash of the key. The index is taken from the top bits 
+    // of the product, which depend on every bit of the key, since positions only reach the high half.
+    auto key = (
+        reinterpret_cast<std::uintptr_t>(parser) ^ 
+        ((std::uint64_t) (unsigned int) (position + this->_offset) << 32) ^ 
+        ((std::uint64_t) (unsigned int) this->_offset << 16) ^ 
+        this->_context
+    );
+    std::size_t mask = this->_slots.size() - 1;
+    std::size_t index = (key * 0x9E3779B97F4A7C15ull) >> std::countl_zero((std::uint64_t) mask);
+    while (true) {
+        auto& slot = this->_slots[index];
+        if (
+            slot.parser == nullptr || 
+            (
+                slot.parser == parser && slot.position == position && 
+                slot.context == this->_context && slot.offset == this->_offset
+            )
+        ) {
+            return slot;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void Parsing::ParseSession::_rebuild()
+{
+    auto slots = std::move(this->_slots);
+    std::size_t entries = std::count_if(slots.begin(), slots.end(), [offset = this->_offset](auto& slot) {
+        return slot.parser != nullptr && slot.offset == offset;
+    });
+    std::size_t size = initialSlots;
+    while (4 * entries > size) {
+        size = 2 * size;
+    }
+    this->_slots = std::vector<DSlot>(size, DSlot{nullptr, 0, 0, 0, ParseResult::failure(0, -1)});
+    this->_usedSlots = entries;
+    int context = this->_context;
+    for (auto& slot : slots) {
+        if (slot.parser != nullptr && slot.offset == this->_offset) {
+            this->_context = slot.context;
+            this->_slot(slot.parser, slot.position) = slot;
+        }
+    }
+    this->_context = context;
+}
@@ -0,0 +1,117 @@
+#ifndef PARSING_PARSE_SESSION_HH
+#define PARSING_PARSE_SESSION_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include "ParseResult.h"
+
+class IParseable;
+
+namespace Parsing {
+    /**
+     * The state of one run of parsing. A session holds the memo table of a packrat 
+     * parser: the result of every parser at every token position it was tried at, 
+     * so that backtracking alternatives never parse the same rule twice at a position.
+     *
+     * Parsers find the session through ParseSession::current(), which is set for 
+     * the current thread by a ParseSession::Scope for the duration of parsing.
+     *
+     * A result is stored the first time a rule is tried at a position, and later 
+     * attempts are handed the very same expressions, which stay in the arena they 
+     * were parsed into. Parsers therefore never change the expressions they receive 
+     * from their sub-parsers, but rework copies of them made with Expression::copy.
+     */
+    class ParseSession {
+        public:
+            ParseSession(bool memoize = true);
+            /**
+             * Makes a session the current one of the thread until the scope ends.
+             */
+            class Scope {
+                public:
+                    Scope(ParseSession& session);
+                    ~Scope();
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+                private:
+                    ParseSession* _previous;
+            };
+            /**
+             * The session of the thread, or nullptr if parsing happens outside of any session.
+             */
+            static ParseSession* current();
+            bool memoizes();
+            std::optional<ParseResult> findResult(IParseable* parser, int position);
+            void storeResult(IParseable* parser, int position, ParseResult& result);
+            /**
+             * Hands a result of the parser at the position, parsed ahead of time for example 
+             * by another thread, to the next attempt of the parser there in the current 
+             * context. The result is handed out once and without copying.
+             */
+            void prepareResult(IParseable* parser, int position, ParseResult result);
+            bool hasPreparedResults();
+            std::optional<ParseResult> takePreparedResult(IParseable* parser, int position);
+            /**
+             * Forgets the prepared results that were not taken.
+             */
+            void discardPreparedResults();
+            /**
+             * Sets the position of the first token that the positions given to the session 
+             * count from, such as the offset of the window of a streamed sequence. Results 
+             * are only reused at the offset they were stored at. The entries of other offsets 
+             * are dropped once the table fills up, so moving on costs nothing right away.
+             */
+            void setOffset(int offset);
+            int offset();
+            /**
+             * Parsers that change the rules of other parsers while parsing set a context 
+             * telling which rules are in effect, so that results are only reused in the 
+             * same context.
+             */
+            int context();
+            void setContext(int context);
+            long long hits();
+            long long misses();
+            double hitRate();
+            /**
+             * The amount of positions rules have been tried at.
+             */
+            std::size_t memoEntries();
+            /**
+             * The memory used by the memo table. The memoized expressions are 
+             * not included, since they are part of the tree being parsed.
+             */
+            std::size_t memoBytes();
+        private:
+            /**
+             * A slot of the open addressing memo table, empty while it has no parser.
+             */
+            struct DSlot {
+                IParseable* parser;
+                int position;
+                int context;
+                int offset;
+                ParseResult result;
+            };
+            bool _memoize;
+            int _context;
+            int _offset;
+            std::vector<DSlot> _slots;
+            std::size_t _usedSlots;
+            long long _hits;
+            long long _misses;
+            std::map<std::tuple<IParseable*, int, int>, ParseResult> _preparedResults;
+            DSlot& _slot(IParseable* parser, int position);
+            /**
+             * Rebuilds the table without the entries of other offsets, sized 
+             * so that the entries left fill at most a quarter of it.
+             */
+            void _rebuild();
+    };
+};
+
+#endif
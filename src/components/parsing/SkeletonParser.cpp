@@ -1,116 +1,114 @@
 #include "SkeletonParser.h"
+#include "GrammarAnalysis.h"
 #include <iostream>
 
+namespace {
+    // The operations of pattern instructions.
+    const int matchValue = 0;
+    const int matchKind = 1;
+    const int parseExpression = 2;
+    const int mismatch = 3;
+    const int trailBeforeValue = 4;
+    const int trailBeforeKind = 5;
+    const int trailBeforeExpression = 6;
+    const int trailToEnd = 7;
+}
+
 Parsing::SkeletonParser::SkeletonParser(
     std::string type,
     std::vector<std::pair<std::string, std::string>> pattern, 
     std::map<std::string, IParseable*> parsers
 ): _type(type), _pattern(pattern), _parsers(parsers) {
-
+    this->_compile();
 }
 
-std::shared_ptr<Expression> Parsing::SkeletonParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult Parsing::SkeletonParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
     auto sequence = TokenSequence{tokens};
 	sequence.setPosition(position);
 
-    auto expressions = std::vector<std::shared_ptr<Expression>>{};
+    auto expressions = std::vector<Expression*>{};
     auto expressionTokens = std::vector<DToken>{};
-    int optionalityLevel = 0;
 
-    for (int i = 0; i < ((int) this->_pattern.size()); i++) {
-        auto element = this->_pattern.at(i);
-        auto elementType = element.first;
-        auto elementValue = element.second;
-        // If the pattern is next expecting to see a token and a matching one is encountered.
-        if (
-            (elementType == "token-value" && sequence.peek().value == elementValue) || 
-            (elementType == "token-type" && sequence.peek().type == elementValue)
-        ) {
-            auto token = sequence.consume();
-            // If the next token is expected to match a token type instead of a literal token value.
-            if (elementType == "token-type") {
-                // Then we create a literal expression from the token and add it to the 
-                // pattern expressions values.
-                auto expression = std::shared_ptr<Expression>(
-                    new Expression{
-                        elementValue,
-                        sequence.position() - 1,
-                        sequence.position()
-                    }
-                );
-                expression->tokens().insert(expression->tokens().end(), token);
-                expressionTokens.insert(expressionTokens.end(), token);
-                expressions.insert(expressions.end(), expression);
-            } else {
-                // Conversely, a token that is matched by 
-                // literal value is not added to the pattern expression's children, since 
-                // it is interpreted to give no semantic extra information (because every expression matching 
-                // the pattern will always have the same literal tokens). Instead, 
-                // the literal token is added to the skeleton expression's list of its own tokens.
-                expressionTokens.insert(expressionTokens.end(), token);
-            }
-
-        } else if (elementType == "expression" && this->_parsers.contains(elementValue)) {
-            // If the pattern element is an expression that is recognized, we attempt to parse it using 
-            // the given parsing rule.
-            auto parser = this->_parsers.at(elementValue);
-            auto canParse = parser->canParseAt(sequence.tokens(), sequence.position());
-            // If we can parse the expression.
-            if (canParse) {
-                auto expression = parser->parse(sequence.tokens(), sequence.position());
-                expressions.insert(expressions.end(), expression);
-                sequence.setPosition(expression->endPos());
-            } else if (optionalityLevel == 0 || (this->_pattern.at(i - 1).first != "optional" && this->_pattern.at(i - 1).first != "trail")) {
-                // Else, if the expression is not optional or we are more than one element deep into an optional section.
-                throw std::runtime_error(
-                    "Unexpected token '" + elementValue + "' encountered at " + sequence.peek().startLocation.toString()
-                );
-            }
-        } else if (elementType == "trail") {
-            // If the pattern has an optional trailing portion but the next part of the pattern 
-            // does not match it, we end parsing.
-            // If the trail element is the last pattern element we also wish to end parsing.
-            if (
-                (i == ((int) this->_pattern.size() - 1))  || 
-                !(this->_nextPatternElementMatches(this->_pattern.at(i + 1), sequence.peek()))
-            ) {
+    int i = 0;
+    int end = (int) this->_program.size();
+    while (i < end) {
+        auto& instruction = this->_program[i];
+        auto& token = sequence.peek();
+        switch (instruction.operation) {
+            case matchValue:
+                // A token that is matched by literal value is not added to the pattern expression's children, 
+                // since every expression matching the pattern has the same literal tokens. Instead, it is 
+                // added to the skeleton expression's list of its own tokens.
+                if (token.symbol == instruction.symbol) {
+                    expressionTokens.insert(expressionTokens.end(), sequence.consume());
+                    i = i + 1;
+                    continue;
+                }
+                break;
+            case matchKind:
+                // A token that is matched by type becomes a literal expression of its own.
+                if (token.kind == instruction.symbol) {
+                    auto expression = Expression::create(
+                        this->_pattern[instruction.element].second,
+                        sequence.position(),
+                        sequence.position() + 1
+                    );
+                    Expression::addToken(expression, token);
+                    expressionTokens.insert(expressionTokens.end(), sequence.consume());
+                    expressions.insert(expressions.end(), expression);
+                    i = i + 1;
+                    continue;
+                }
+                break;
+            case parseExpression: {
+                // Parsers that cannot start with the next token are not tried at all.
+                auto parser = instruction.parser;
+                if (!parser->admits(token)) {
+                    break;
+                }
+                auto parseResult = parser->tryParse(sequence.tokens(), sequence.position());
+                if (parseResult.succeeded()) {
+                    auto& expression = parseResult.expression();
+                    expressions.insert(expressions.end(), expression);
+                    sequence.setPosition(expression->endPos());
+                    i = i + 1;
+                    continue;
+                } else if (parser->commitsAt(sequence.tokens(), sequence.position())) {
+                    // The parser took on the expression but failed, which is an error even in an optional section.
+                    return parseResult;
+                }
                 break;
-            } else {
-                // Else, we advance to the next pattern element to continue parsing from there.
-                optionalityLevel = optionalityLevel + 1;
-                continue;
             }
-        } else if (elementType == "optional") {
-            // If the element is a meta-element denoting the beginning of an optional section.
-            optionalityLevel = optionalityLevel + 1;
-
-        } else if (elementType == "/optional") {
-            // If the element is a meta-element denoting the end of an optional section.
-            optionalityLevel = optionalityLevel - 1;
-
-        } else if (optionalityLevel > 0) {
-            // If no rule was matched for the next pattern element but we are in an optional section, we 
-            // skip to the end of the current optional section.
-            auto skippableElement = this->_pattern.at(i);
-            while (skippableElement.first != "/optional" && i + 1 < ((int) this->_pattern.size())) {
+            case trailBeforeValue:
+                i = token.symbol == instruction.symbol ? i + 1 : end;
+                continue;
+            case trailBeforeKind:
+                i = token.kind == instruction.symbol ? i + 1 : end;
+                continue;
+            case trailBeforeExpression:
                 i = i + 1;
-                skippableElement = this->_pattern.at(i);
-            }
-            optionalityLevel = optionalityLevel - 1;
-        } else {
-            throw std::runtime_error(
-                "Unexpected token '" + elementValue + "' encountered at " + sequence.peek().startLocation.toString()
+                continue;
+            case trailToEnd:
+                i = end;
+                continue;
+        }
+
+        // The element did not match.
+        if (instruction.fallback == -1) {
+            return ParseResult::failure(
+                ParseResult::unexpectedElement, 
+                sequence.position(), 
+                &this->_pattern[instruction.element].second
             );
         }
+        i = instruction.fallback;
     }
 
-    auto result = std::shared_ptr<Expression>(
-        new Expression{
-            this->_type,
-            position,
-            sequence.position()
-        }
+    auto result = Expression::create(
+        this->_type,
+        position,
+        sequence.position()
     );
     result->setChildren(expressions);
     result->setTokens(expressionTokens);
@@ -118,14 +116,100 @@ std::shared_ptr<Expression> Parsing::SkeletonParser::parse(std::vector<DToken>&
     return result;
 }
 
-bool Parsing::SkeletonParser::_nextPatternElementMatches(std::pair<std::string, std::string> element, DToken token)
+void Parsing::SkeletonParser::_compile()
 {
-    auto elementType = element.first;
-    auto elementValue = element.second;
+    int size = (int) this->_pattern.size();
 
-    return (
-        (elementType == "token-value" && token.value == elementValue) || 
-        (elementType == "token-type" && token.type == elementValue) || 
-        (elementType == "expression" && this->_parsers.contains(elementValue))
-    );
+    // The pattern elements compile into at most one instruction each, so we first find the 
+    // instruction that each element compiles into or, for meta-elements, the one following it.
+    auto instructionIndices = std::vector<int>{};
+    int instructionCount = 0;
+    for (auto& [elementType, elementValue] : this->_pattern) {
+        instructionIndices.push_back(instructionCount);
+        if (elementType != "optional" && elementType != "/optional") {
+            instructionCount = instructionCount + 1;
+        }
+    }
+    instructionIndices.push_back(instructionCount);
+
+    int optionalityLevel = 0;
+    for (int i = 0; i < size; i++) {
+        auto& [elementType, elementValue] = this->_pattern.at(i);
+        if (elementType == "optional" || elementType == "trail") {
+            // The optional section, or the trailing portion of the pattern, begins.
+            optionalityLevel = optionalityLevel + 1;
+        } else if (elementType == "/optional") {
+            optionalityLevel = optionalityLevel - 1;
+        }
+        if (elementType == "optional" || elementType == "/optional") {
+            continue;
+        }
+
+        // An element that does not match in an optional section skips to the end of the section.
+        int skip = i;
+        while (skip + 1 < size && this->_pattern.at(skip).first != "/optional") {
+            skip = skip + 1;
+        }
+        auto instruction = DInstruction{
+            mismatch, 
+            -1, 
+            nullptr, 
+            i, 
+            optionalityLevel > 0 ? instructionIndices.at(skip + 1) : -1, 
+            optionalityLevel > 0
+        };
+
+        if (elementType == "token-value" || elementType == "token-type") {
+            instruction.operation = elementType == "token-value" ? matchValue : matchKind;
+            instruction.symbol = Tokenization::Symbols::id(elementValue);
+        } else if (elementType == "expression" && this->_parsers.contains(elementValue)) {
+            instruction.operation = parseExpression;
+            instruction.parser = this->_parsers.at(elementValue);
+            // An expression that does not parse can only be left out right at the start of an optional section.
+            auto& previousType = this->_pattern.at(i - (i > 0 ? 1 : 0)).first;
+            bool skippable = optionalityLevel > 0 && (previousType == "optional" || previousType == "trail");
+            instruction.fallback = skippable ? instructionIndices.at(i) + 1 : -1;
+        } else if (elementType == "trail") {
+            // The trailing portion is parsed only if the next token can start the element following the trail.
+            instruction.operation = trailToEnd;
+            instruction.fallback = -1;
+            if (i + 1 < size) {
+                auto& [nextType, nextValue] = this->_pattern.at(i + 1);
+                if (nextType == "token-value" || nextType == "token-type") {
+                    instruction.operation = nextType == "token-value" ? trailBeforeValue : trailBeforeKind;
+                    instruction.symbol = Tokenization::Symbols::id(nextValue);
+                } else if (nextType == "expression" && this->_parsers.contains(nextValue)) {
+                    instruction.operation = trailBeforeExpression;
+                }
+            }
+        }
+        this->_program.push_back(instruction);
+    }
+}
+
+Parsing::FirstSet Parsing::SkeletonParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    // The instructions are followed from the start for as long as the ones before them can be skipped or be empty.
+    auto firstSet = FirstSet{};
+    for (auto& instruction : this->_program) {
+        bool empty = false;
+        if (instruction.operation == matchValue || instruction.operation == matchKind) {
+            firstSet.insert(instruction.symbol);
+        } else if (instruction.operation == parseExpression) {
+            auto elementFirstSet = analysis.firstSet(instruction.parser);
+            empty = elementFirstSet.nullable();
+            elementFirstSet.setNullable(false);
+            firstSet.insert(elementFirstSet);
+        } else if (instruction.operation != mismatch) {
+            // The rest of the pattern may be left out.
+            firstSet.setNullable(true);
+            continue;
+        }
+        // An element that has to match ends the first set, unless it is in an optional section.
+        if (!empty && !instruction.optional) {
+            return firstSet;
+        }
+    }
+    firstSet.setNullable(true);
+    return firstSet;
 }
\ No newline at end of file
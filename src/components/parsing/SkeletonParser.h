@@ -14,12 +14,29 @@ namespace Parsing {
                 std::vector<std::pair<std::string, std::string>> pattern, 
                 std::map<std::string, IParseable*> parsers
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
+            /**
+             * An instruction of the compiled pattern. Matching instructions test the next token 
+             * against a symbol or call a parser, and when they do not match, parsing continues at 
+             * the fallback instruction, or fails if the fallback is -1. Trail instructions end 
+             * parsing successfully unless the next token can start the element after them.
+             */
+            struct DInstruction {
+                int operation;
+                int symbol;
+                IParseable* parser;
+                int element;
+                int fallback;
+                bool optional;
+            };
             std::string _type;
             std::vector<std::pair<std::string, std::string>> _pattern;
             std::map<std::string, IParseable*> _parsers;
-            bool _nextPatternElementMatches(std::pair<std::string, std::string> element, DToken token);
+            std::vector<DInstruction> _program;
+            void _compile();
     };
 };
 
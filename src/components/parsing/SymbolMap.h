@@ -0,0 +1,40 @@
+#ifndef PARSING_SYMBOL_MAP_HH
+#define PARSING_SYMBOL_MAP_HH
+
+#include <vector>
+
+namespace Parsing {
+    /**
+     * A map from interned symbols to values stored as a flat array 
+     * indexed by the symbol. Symbols without a value map to the default value.
+     */
+    template <typename T>
+    class SymbolMap {
+        public:
+            SymbolMap(T defaultValue = T{}): _defaultValue(defaultValue) {}
+
+            void set(int symbol, T value) {
+                if (symbol >= (int) this->_values.size()) {
+                    this->_values.resize(symbol + 1, this->_defaultValue);
+                }
+                this->_values[symbol] = value;
+            }
+
+            T at(int symbol) const {
+                if (symbol >= 0 && symbol < (int) this->_values.size()) {
+                    return this->_values[symbol];
+                } else {
+                    return this->_defaultValue;
+                }
+            }
+
+            void clear() {
+                this->_values.clear();
+            }
+        private:
+            T _defaultValue;
+            std::vector<T> _values;
+    };
+};
+
+#endif
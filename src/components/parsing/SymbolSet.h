@@ -0,0 +1,59 @@
+#ifndef PARSING_SYMBOL_SET_HH
+#define PARSING_SYMBOL_SET_HH
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+#include "../tokenization/Symbols.h"
+
+namespace Parsing {
+    /**
+     * A set of interned symbols stored as a bitset, so that token kinds 
+     * and values can be tested for membership without comparing strings.
+     */
+    class SymbolSet {
+        public:
+            SymbolSet() {}
+
+            SymbolSet(const std::set<std::string>& names) {
+                for (auto& name : names) {
+                    this->insert(Tokenization::Symbols::id(name));
+                }
+            }
+
+            void insert(int symbol) {
+                if (symbol / 64 >= (int) this->_bits.size()) {
+                    this->_bits.resize(symbol / 64 + 1, 0);
+                }
+                this->_bits[symbol / 64] |= std::uint64_t{1} << (symbol % 64);
+            }
+
+            /**
+             * Adds the symbols of the other set, returning whether any of them were new.
+             */
+            bool insert(const SymbolSet& other) {
+                if (other._bits.size() > this->_bits.size()) {
+                    this->_bits.resize(other._bits.size(), 0);
+                }
+                bool changed = false;
+                for (int i = 0; i < (int) other._bits.size(); i++) {
+                    changed = changed || (other._bits[i] & ~this->_bits[i]) != 0;
+                    this->_bits[i] |= other._bits[i];
+                }
+                return changed;
+            }
+
+            bool contains(int symbol) const {
+                return (
+                    symbol >= 0 && 
+                    symbol / 64 < (int) this->_bits.size() && 
+                    ((this->_bits[symbol / 64] >> (symbol % 64)) & 1)
+                );
+            }
+        private:
+            std::vector<std::uint64_t> _bits;
+    };
+};
+
+#endif
@@ -1,31 +1,58 @@
 #include "TokenSequence.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
+
+namespace {
+    // The amount of tokens a window may keep before released tokens are dropped eagerly.
+    const int fewestKeptTokens = 64;
+}
 
 TokenSequence::TokenSequence(std::vector<DToken>& tokens):
-    _tokens(tokens), _position(0) {
+    _tokens(&tokens), _stream(nullptr), _offset(0), _position(0) {
     assert(tokens.size() != 0);
+    auto& lastToken = tokens.back();
+    this->_endToken = DToken{
+        Tokenization::Symbols::end,
+        -1,
+        lastToken.offset + lastToken.length,
+        0,
+        lastToken.source
+    };
+}
+
+TokenSequence::TokenSequence(Tokenization::TokenStream& stream):
+    _tokens(nullptr), _stream(&stream), _offset(0), _position(0), _endToken() {
+
+}
+
+const DToken& TokenSequence::peek() {
+    return this->peek(0);
 }
 
-DToken TokenSequence::peek() {
-    if (this->_position < (int) (this->_tokens.size())) {
-        return this->_tokens.at(this->_position);
+const DToken& TokenSequence::peek(int distance) {
+    auto& tokens = this->tokens();
+    int index = this->_position + distance - this->_offset;
+    if (index < 0) {
+        throw std::out_of_range("The token has already been released from the sequence.");
+    }
+    // Pull tokens from the stream until the window reaches the requested one.
+    while (this->_stream != nullptr && index >= (int) tokens.size() && !this->_stream->finished()) {
+        tokens.push_back(this->_stream->next());
+        if (this->_stream->finished()) {
+            this->_endToken = tokens.back();
+        }
+    }
+    if (index < (int) (tokens.size())) {
+        return tokens[index];
     } else {
-        auto lastToken = (*(this->_tokens.end() - 1));
-        auto endToken = DToken{
-            "end",
-            "",
-            lastToken.endPos,
-            lastToken.endPos,
-            lastToken.endLocation,
-            lastToken.endLocation
-        };
-        return endToken;
+        return this->_endToken;
     }
 }
 
-DToken TokenSequence::consume() {
-    auto token = this->peek();
+const DToken& TokenSequence::consume() {
+    auto& token = this->peek();
     this->_position = this->_position + 1;
     return token;
 }
@@ -40,5 +67,25 @@ int TokenSequence::position() {
 
 std::vector<DToken>& TokenSequence::tokens()
 {
-    return this->_tokens;
-}
\ No newline at end of file
+    return this->_stream != nullptr ? this->_window : *(this->_tokens);
+}
+
+int TokenSequence::offset() {
+    return this->_offset;
+}
+
+void TokenSequence::release(int position) {
+    if (this->_stream == nullptr || position <= this->_offset) {
+        return;
+    }
+    int amount = std::min(position - this->_offset, (int) this->_window.size());
+    // Dropping tokens moves the ones kept to the front. When many are kept, the tokens are 
+    // only dropped once there are at least as many of them, so each token is moved at most 
+    // a few times on average.
+    int kept = (int) this->_window.size() - amount;
+    if (kept > fewestKeptTokens && amount < kept) {
+        return;
+    }
+    this->_window.erase(this->_window.begin(), this->_window.begin() + amount);
+    this->_offset = this->_offset + amount;
+}
@@ -2,23 +2,53 @@
 #define PARSING_TOKEN_SEQUENCE_HH
 
 #include "../tokenization/DToken.h"
+#include "../tokenization/TokenStream.h"
 #include <vector>
 
 /**
  * A data structure containing the tokens that are 
- * processed during parsing.
+ * processed during parsing. Tokens are handed out by 
+ * reference, and reading past the last token yields an end token.
+ *
+ * A sequence can also be pulled from a token stream, in which case 
+ * tokens are only tokenized once they are peeked at. It then only holds 
+ * a window of the tokens, starting at offset(), that the owner shrinks 
+ * with release() once it no longer needs to look back at them.
  */
 class TokenSequence {
     public:
         TokenSequence(std::vector<DToken>& tokens);
-        DToken peek();
-        DToken consume();
+        TokenSequence(Tokenization::TokenStream& stream);
+        const DToken& peek();
+        /**
+         * Returns the token at the given distance from the current position. 
+         * The distance may be negative to look back at tokens still in the window.
+         */
+        const DToken& peek(int distance);
+        const DToken& consume();
         void setPosition(int position);
         int position();
+        /**
+         * The tokens held by the sequence. For a streamed sequence, these are 
+         * the tokens of the window, so the token at position p is at index p - offset().
+         */
         std::vector<DToken>& tokens();
+        /**
+         * The position of the first token held by the sequence.
+         */
+        int offset();
+        /**
+         * Lets a streamed sequence drop the tokens before the given position. While the 
+         * window holds many tokens after them, they may be kept until more are released.
+         */
+        void release(int position);
     private:
-        std::vector<DToken>& _tokens;
+        std::vector<DToken>* _tokens;
+        std::vector<DToken> _window;
+        Tokenization::TokenStream* _stream;
+        int _offset;
         int _position;
+        DToken _endToken;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,4 +1,5 @@
 #include "UnaryParser.h"
+#include "GrammarAnalysis.h"
 
 UnaryParser::UnaryParser(
         std::string operatorType,
@@ -11,29 +12,39 @@ UnaryParser::UnaryParser(
     
 }
 
-std::shared_ptr<Expression> UnaryParser::parse(std::vector<DToken>& tokens, int position) {
+Parsing::ParseResult UnaryParser::_tryParse(std::vector<DToken>& tokens, int position) {
     auto tokenSequence = TokenSequence{tokens};
     tokenSequence.setPosition(position);
-    auto firstToken = tokenSequence.consume();
+    auto& firstToken = tokenSequence.consume();
     
     // If the first token we encounter is the operator.
-    if (this->_acceptableOperators.contains(firstToken.type)) {
+    if (this->_acceptableOperators.contains(firstToken.kind)) {
         // Get the expression after the operator.
-        auto followingExpression = this->_expressionParser.parse(tokens, tokenSequence.position());
+        auto followingResult = this->_expressionParser.tryParse(tokens, tokenSequence.position());
+        if (!followingResult.succeeded()) {
+            return followingResult;
+        }
+        auto& followingExpression = followingResult.expression();
 
-        auto unaryExpression = std::shared_ptr<Expression>(
-            new Expression{
-                this->_operatorType,
-                position,
-                followingExpression->endPos()
-            }
+        auto unaryExpression = Expression::create(
+            this->_operatorType,
+            position,
+            followingExpression->endPos()
         );
-        unaryExpression->tokens().insert(unaryExpression->tokens().end(), firstToken);
-        unaryExpression->subTypes().insert({"name", firstToken.value});
+        Expression::addToken(unaryExpression, firstToken);
+        unaryExpression->subTypes().insert({"name", std::string{firstToken.value()}});
 
         Expression::addChild(unaryExpression, followingExpression);
         return unaryExpression;
     } else {
-        throw std::runtime_error("Expected the operator '" + this->_operatorType + "' at " + firstToken.startLocation.toString());
+        return Parsing::ParseResult::failure(Parsing::ParseResult::missingUnaryOperator, position, &this->_operatorType);
     }
+}
+
+Parsing::FirstSet UnaryParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    auto firstSet = Parsing::FirstSet{};
+    firstSet.insert(this->_acceptableOperators);
+    analysis.firstSet(&this->_expressionParser);
+    return firstSet;
 }
\ No newline at end of file
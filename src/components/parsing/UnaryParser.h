@@ -7,6 +7,7 @@
 #include <string>
 #include <functional>
 #include <set>
+#include "SymbolSet.h"
 #include "TExpressions.h"
 #include <iostream>
 
@@ -20,11 +21,13 @@ class UnaryParser: public IParseable {
             std::set<std::string> acceptableOperators,
             IParseable& expressionParser
         );
-        std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+        Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+    protected:
+        Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
     private:
         std::string _operatorType;
         IParseable& _expressionParser;
-        std::set<std::string> _acceptableOperators;
+        Parsing::SymbolSet _acceptableOperators;
 };
 
 #endif
\ No newline at end of file
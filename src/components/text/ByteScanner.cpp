@@ -0,0 +1,169 @@
+#include "ByteScanner.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define TEXT_BYTE_SCANNER_X86 1
+    #include <immintrin.h>
+#endif
+
+namespace {
+    // Returns the ranges of consecutive byte values in the set, or of the bytes not in it.
+    std::vector<std::array<unsigned char, 2>> rangesOf(const std::array<bool, 256>& set, bool value) {
+        auto ranges = std::vector<std::array<unsigned char, 2>>{};
+        for (int byte = 0; byte < 256; byte++) {
+            if (set[byte] != value) {
+                continue;
+            }
+            if (!ranges.empty() && ranges.back()[1] + 1 == byte) {
+                ranges.back()[1] = (unsigned char) byte;
+            } else {
+                ranges.push_back({(unsigned char) byte, (unsigned char) byte});
+            }
+        }
+        return ranges;
+    }
+
+    const int scalarKernel = 0;
+    const int sse2Kernel = 1;
+    const int avx2Kernel = 2;
+
+    // Selects the kernel on first use, since scanners may already 
+    // be used while other static objects are initialized.
+    int selectedKernel() {
+        static const int kernel = []() {
+            #ifdef TEXT_BYTE_SCANNER_X86
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) {
+                    return avx2Kernel;
+                }
+                if (__builtin_cpu_supports("sse2")) {
+                    return sse2Kernel;
+                }
+            #endif
+            return scalarKernel;
+        }();
+        return kernel;
+    }
+
+    #ifdef TEXT_BYTE_SCANNER_X86
+        // A byte x is in [low, high] when x - low, computed with wraparound, is 
+        // at most high - low. The saturating subtraction is zero exactly then.
+        __attribute__((target("sse2")))
+        inline __m128i inRange16(__m128i bytes, unsigned char low, unsigned char high) {
+            auto shifted = _mm_sub_epi8(bytes, _mm_set1_epi8((char) low));
+            auto excess = _mm_subs_epu8(shifted, _mm_set1_epi8((char) (high - low)));
+            return _mm_cmpeq_epi8(excess, _mm_setzero_si128());
+        }
+
+        __attribute__((target("avx2")))
+        inline __m256i inRange32(__m256i bytes, unsigned char low, unsigned char high) {
+            auto shifted = _mm256_sub_epi8(bytes, _mm256_set1_epi8((char) low));
+            auto excess = _mm256_subs_epu8(shifted, _mm256_set1_epi8((char) (high - low)));
+            return _mm256_cmpeq_epi8(excess, _mm256_setzero_si256());
+        }
+    #endif
+}
+
+Text::ByteScanner::ByteScanner(const std::array<bool, 256>& set):
+    _set(set),
+    _ranges(rangesOf(set, true)),
+    _negated(false)
+{
+    auto complement = rangesOf(set, false);
+    if (complement.size() < this->_ranges.size()) {
+        this->_ranges = complement;
+        this->_negated = true;
+    }
+}
+
+bool Text::ByteScanner::supports(const std::array<bool, 256>& set) {
+    return (int) std::min(rangesOf(set, true).size(), rangesOf(set, false).size()) <= maxRanges;
+}
+
+std::size_t Text::ByteScanner::span(const char* begin, const char* end) const {
+    int kernel = selectedKernel();
+    if (kernel == avx2Kernel) {
+        return this->spanAvx2(begin, end);
+    } else if (kernel == sse2Kernel) {
+        return this->spanSse2(begin, end);
+    } else {
+        return this->spanScalar(begin, end);
+    }
+}
+
+std::size_t Text::ByteScanner::spanScalar(const char* begin, const char* end) const {
+    const char* position = begin;
+    while (position < end && this->_set[(unsigned char) *position]) {
+        position++;
+    }
+    return position - begin;
+}
+
+#ifdef TEXT_BYTE_SCANNER_X86
+
+__attribute__((target("sse2")))
+std::size_t Text::ByteScanner::spanSse2(const char* begin, const char* end) const {
+    const char* position = begin;
+    while (end - position >= 16) {
+        auto bytes = _mm_loadu_si128((const __m128i*) position);
+        auto matches = _mm_setzero_si128();
+        for (auto& range : this->_ranges) {
+            matches = _mm_or_si128(matches, inRange16(bytes, range[0], range[1]));
+        }
+        // Bits are set for the bytes that end the run.
+        unsigned int stops = (unsigned int) _mm_movemask_epi8(matches);
+        if (!this->_negated) {
+            stops = ~stops & 0xFFFF;
+        }
+        if (stops != 0) {
+            return (position - begin) + __builtin_ctz(stops);
+        }
+        position += 16;
+    }
+    return (position - begin) + this->spanScalar(position, end);
+}
+
+__attribute__((target("avx2")))
+std::size_t Text::ByteScanner::spanAvx2(const char* begin, const char* end) const {
+    const char* position = begin;
+    while (end - position >= 32) {
+        auto bytes = _mm256_loadu_si256((const __m256i*) position);
+        auto matches = _mm256_setzero_si256();
+        for (auto& range : this->_ranges) {
+            matches = _mm256_or_si256(matches, inRange32(bytes, range[0], range[1]));
+        }
+        // Bits are set for the bytes that end the run.
+        unsigned int stops = (unsigned int) _mm256_movemask_epi8(matches);
+        if (!this->_negated) {
+            stops = ~stops;
+        }
+        if (stops != 0) {
+            return (position - begin) + __builtin_ctz(stops);
+        }
+        position += 32;
+    }
+    return (position - begin) + this->spanSse2(position, end);
+}
+
+#else
+
+std::size_t Text::ByteScanner::spanSse2(const char* begin, const char* end) const {
+    return this->spanScalar(begin, end);
+}
+
+std::size_t Text::ByteScanner::spanAvx2(const char* begin, const char* end) const {
+    return this->spanScalar(begin, end);
+}
+
+#endif
+
+std::string Text::ByteScanner::kernel() {
+    int kernel = selectedKernel();
+    if (kernel == avx2Kernel) {
+        return "avx2";
+    } else if (kernel == sse2Kernel) {
+        return "sse2";
+    } else {
+        return "scalar";
+    }
+}
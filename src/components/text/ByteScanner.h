@@ -0,0 +1,50 @@
+#ifndef TEXT_BYTE_SCANNER_HH
+#define TEXT_BYTE_SCANNER_HH
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Text {
+    /**
+     * Finds the end of a run of bytes from a fixed set, like whitespace, identifier 
+     * characters or everything but a line break. The set is stored as a few byte 
+     * ranges, so that SSE2 or AVX2 kernels can test 16 or 32 bytes at a time. The 
+     * kernel is selected once at runtime from what the processor supports, with a 
+     * scalar fallback.
+     */
+    class ByteScanner {
+        public:
+            /**
+             * The most ranges a set may consist of, counting either the 
+             * ranges of the set or the ranges of its complement.
+             */
+            static constexpr int maxRanges = 6;
+            ByteScanner(const std::array<bool, 256>& set);
+            /**
+             * Whether the set can be described with at most maxRanges ranges.
+             */
+            static bool supports(const std::array<bool, 256>& set);
+            /**
+             * Returns the length of the run of bytes in the set that starts at begin.
+             */
+            std::size_t span(const char* begin, const char* end) const;
+            std::size_t spanScalar(const char* begin, const char* end) const;
+            std::size_t spanSse2(const char* begin, const char* end) const;
+            std::size_t spanAvx2(const char* begin, const char* end) const;
+            /**
+             * The name of the kernel used by span: "avx2", "sse2" or "scalar".
+             */
+            static std::string kernel();
+        private:
+            std::array<bool, 256> _set;
+            /**
+             * The ranges [low, high] of the set, or of its complement if _negated is set.
+             */
+            std::vector<std::array<unsigned char, 2>> _ranges;
+            bool _negated;
+    };
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef TEXT_DAUTOMATON_HH
+#define TEXT_DAUTOMATON_HH
+
+#include <array>
+#include <vector>
+
+namespace Text {
+    /**
+     * The data of a deterministic finite automaton over bytes. Input bytes are first
+     * mapped to equivalence classes so that the transition table only needs one
+     * column per class instead of one per byte value.
+     */
+    struct DAutomaton {
+        /**
+         * The equivalence class of each byte value.
+         */
+        std::array<int, 256> byteClasses {};
+        int classCount = 0;
+        int startState = -1;
+        /**
+         * Row-major transition table of size (amount of states) * classCount.
+         * A value of -1 denotes the dead state.
+         */
+        std::vector<int> transitions {};
+        /**
+         * The highest priority rule accepted in each state, or -1 if the
+         * state is not accepting.
+         */
+        std::vector<int> acceptingRules {};
+    };
+};
+
+#endif
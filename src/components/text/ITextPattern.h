@@ -1,8 +1,8 @@
 #ifndef TEXT_ITEXTPATTERN_HH
 #define TEXT_ITEXTPATTERN_HH
 
-#include <string>
-#include <utility>
+#include <cstddef>
+#include <string_view>
 
 /**
  * A pattern found in text.
@@ -10,10 +10,11 @@
 class ITextPattern {
     public:
         /**
-         * Returns the position of the pattern and the matched 
-         * text. If no match found, returns the pair (null location, "").
+         * Returns the length of the pattern matched starting exactly at the 
+         * given offset of the source, or -1 if it does not match there. Text 
+         * after the offset is only looked at as far as the match extends.
          */
-        virtual std::pair<int, std::string> recognize(std::string text) = 0;
+        virtual int recognizeAt(std::string_view source, std::size_t offset) = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
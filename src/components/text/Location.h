@@ -14,6 +14,10 @@ namespace Text {
         public:
             Location();
             Location(int positionIndex, int line, int column);
+            /**
+             * Counts the line and column from the start of the text, which takes 
+             * linear time. Text::Source::location gives the same result from an index.
+             */
             Location(int positionIndex, const std::string::iterator textStart);
             int positionIndex();
             int line();
@@ -0,0 +1,129 @@
+#include "RegexAutomaton.h"
+#include "RegexCompiler.h"
+
+namespace {
+    // The amount of times in a row a state has to loop back to itself before the 
+    // rest of the run is skipped with a scanner.
+    const int scanAfterLoopLength = 4;
+}
+
+Text::RegexAutomaton::RegexAutomaton(std::vector<std::string> regexes):
+    _automaton(RegexCompiler::compile(regexes))
+{
+    this->_buildLoopScanners();
+}
+
+Text::RegexAutomaton::RegexAutomaton(DAutomaton automaton):
+    _automaton(automaton)
+{
+    this->_buildLoopScanners();
+}
+
+std::pair<int, int> Text::RegexAutomaton::match(std::string_view text, std::size_t offset) const {
+    const int* transitions = this->_automaton.transitions.data();
+    const int* byteClasses = this->_automaton.byteClasses.data();
+    const int* acceptingRules = this->_automaton.acceptingRules.data();
+    const int classCount = this->_automaton.classCount;
+    const std::shared_ptr<ByteScanner>* loopScanners = this->_loopScanners.data();
+    const char* data = text.data();
+    int state = this->_automaton.startState;
+    int loopLength = 0;
+    std::pair<int, int> longest {acceptingRules[state], 0};
+    // Run the automaton until it dies, remembering the last accepting state.
+    for (std::size_t position = offset; position < text.size(); position++) {
+        int nextState = transitions[state * classCount + byteClasses[(unsigned char) data[position]]];
+        if (nextState == -1) {
+            break;
+        }
+        // Once the automaton has stayed in the same state for a while, we skip the 
+        // rest of the run with the scanner. Most runs, like short identifiers, end 
+        // before that and would only be slowed down by it.
+        if (nextState != state) {
+            loopLength = 0;
+        } else if (++loopLength == scanAfterLoopLength && loopScanners[state] != nullptr) {
+            position += loopScanners[state]->span(data + position + 1, data + text.size());
+            loopLength = 0;
+        }
+        state = nextState;
+        if (acceptingRules[state] != -1) {
+            longest = {acceptingRules[state], (int) (position - offset + 1)};
+        }
+    }
+    return longest;
+}
+
+bool Text::RegexAutomaton::supports(std::string regex) {
+    try {
+        RegexCompiler::compile(std::vector<std::string>{regex});
+        return true;
+    } catch (const RegexCompiler::UnsupportedRegex&) {
+        return false;
+    }
+}
+
+void Text::RegexAutomaton::_buildLoopScanners() {
+    this->_loopScanners.clear();
+    for (int state = 0; state < this->stateCount(); state++) {
+        auto loop = std::array<bool, 256>{};
+        int loopSize = 0;
+        for (int byte = 0; byte < 256; byte++) {
+            int target = this->_automaton.transitions[
+                state * this->_automaton.classCount + this->_automaton.byteClasses[byte]
+            ];
+            loop[byte] = target == state;
+            loopSize = loopSize + (loop[byte] ? 1 : 0);
+        }
+        // A loop on a single byte value rarely has runs long enough to pay off.
+        if (loopSize > 1 && ByteScanner::supports(loop)) {
+            this->_loopScanners.push_back(std::make_shared<ByteScanner>(loop));
+        } else {
+            this->_loopScanners.push_back(nullptr);
+        }
+    }
+}
+
+int Text::RegexAutomaton::stateCount() const {
+    return (int) this->_automaton.acceptingRules.size();
+}
+
+bool Text::RegexAutomaton::enumerate(std::vector<std::string>& strings, int limit) const {
+    auto prefix = std::string{};
+    auto onPath = std::vector<bool>(this->stateCount(), false);
+    return this->_enumerateFrom(this->_automaton.startState, prefix, onPath, strings, limit);
+}
+
+bool Text::RegexAutomaton::_enumerateFrom(
+    int state, 
+    std::string& prefix, 
+    std::vector<bool>& onPath, 
+    std::vector<std::string>& strings, 
+    int limit
+) const {
+    onPath[state] = true;
+    for (int byte = 0; byte < 256; byte++) {
+        int target = this->_automaton.transitions[
+            state * this->_automaton.classCount + this->_automaton.byteClasses[byte]
+        ];
+        if (target == -1) {
+            continue;
+        }
+        // Every state of the automaton leads to an accepting one, 
+        // so a cycle means that infinitely many strings are accepted.
+        if (onPath[target]) {
+            return false;
+        }
+        prefix.push_back((char) byte);
+        if (this->_automaton.acceptingRules[target] != -1) {
+            if ((int) strings.size() == limit) {
+                return false;
+            }
+            strings.push_back(prefix);
+        }
+        if (!this->_enumerateFrom(target, prefix, onPath, strings, limit)) {
+            return false;
+        }
+        prefix.pop_back();
+    }
+    onPath[state] = false;
+    return true;
+}
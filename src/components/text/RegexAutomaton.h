@@ -0,0 +1,60 @@
+#ifndef TEXT_REGEXAUTOMATON_HH
+#define TEXT_REGEXAUTOMATON_HH
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include "DAutomaton.h"
+#include "ByteScanner.h"
+
+namespace Text {
+    /**
+     * A prioritized set of regular expressions compiled into a single 
+     * table-driven automaton. Matching is anchored at the given offset 
+     * and finds the longest match, preferring the earliest expression 
+     * when several match equally far.
+     *
+     * States that loop back to themselves on a set of bytes, like the states 
+     * inside whitespace, comments and identifiers, skip the whole run of such 
+     * bytes at once with a vectorized ByteScanner.
+     */
+    class RegexAutomaton {
+        public:
+            RegexAutomaton(std::vector<std::string> regexes);
+            RegexAutomaton(DAutomaton automaton);
+            /**
+             * Returns the index of the matched expression and the length of 
+             * the match. If nothing matches, returns the pair (-1, 0).
+             */
+            std::pair<int, int> match(std::string_view text, std::size_t offset) const;
+            /**
+             * Whether the given regular expression can be compiled into an automaton.
+             */
+            static bool supports(std::string regex);
+            /**
+             * Lists every non-empty string the automaton accepts. Returns false if 
+             * there are infinitely many of them or more than the given limit.
+             */
+            bool enumerate(std::vector<std::string>& strings, int limit) const;
+            int stateCount() const;
+        private:
+            DAutomaton _automaton;
+            /**
+             * The scanner for the bytes on which each state loops back to 
+             * itself, or nullptr if the state has no such loop.
+             */
+            std::vector<std::shared_ptr<ByteScanner>> _loopScanners;
+            void _buildLoopScanners();
+            bool _enumerateFrom(
+                int state, 
+                std::string& prefix, 
+                std::vector<bool>& onPath, 
+                std::vector<std::string>& strings, 
+                int limit
+            ) const;
+    };
+};
+
+#endif
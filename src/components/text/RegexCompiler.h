@@ -0,0 +1,550 @@
+#ifndef TEXT_REGEXCOMPILER_HH
+#define TEXT_REGEXCOMPILER_HH
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "DAutomaton.h"
+
+namespace Text {
+    /**
+     * Compiles a prioritized list of regular expressions into one minimized
+     * deterministic automaton that finds the longest match among all of them,
+     * preferring the earliest given expression when several match equally far.
+     *
+     * The supported syntax is the subset of ECMAScript regular expressions
+     * used for token patterns: literals, escapes, character classes, '.',
+     * groups, alternation and the '*', '+' and '?' quantifiers. Anything else
+     * throws an UnsupportedRegex so that callers can fall back to std::regex.
+     *
+     * Everything here is constexpr so that automata can also be built at compile time.
+     */
+    namespace RegexCompiler {
+        class UnsupportedRegex: public std::invalid_argument {
+            public:
+                using std::invalid_argument::invalid_argument;
+        };
+
+        using TByteSet = std::array<std::uint64_t, 4>;
+
+        /**
+         * A state of a Thompson NFA. A consuming state moves to 'next' on any byte
+         * in 'bytes', other states move to 'next' and 'alternative' without input.
+         */
+        struct DNfaState {
+            TByteSet bytes {};
+            bool consumes = false;
+            int next = -1;
+            int alternative = -1;
+            int rule = -1;
+        };
+
+        constexpr void addByte(TByteSet& set, int byte) {
+            set[byte >> 6] |= std::uint64_t{1} << (byte & 63);
+        }
+
+        constexpr bool hasByte(const TByteSet& set, int byte) {
+            return (set[byte >> 6] >> (byte & 63)) & 1;
+        }
+
+        constexpr void addRange(TByteSet& set, int from, int to) {
+            for (int byte = from; byte <= to; byte++) {
+                addByte(set, byte);
+            }
+        }
+
+        constexpr void addSet(TByteSet& set, const TByteSet& other) {
+            for (int i = 0; i < 4; i++) {
+                set[i] |= other[i];
+            }
+        }
+
+        constexpr TByteSet complement(TByteSet set) {
+            for (auto& word : set) {
+                word = ~word;
+            }
+            return set;
+        }
+
+        /**
+         * Parses a single regular expression into NFA states. Follows
+         * the usual recursive descent over alternation, concatenation,
+         * repetition and atoms.
+         */
+        class NfaBuilder {
+            public:
+                constexpr NfaBuilder(std::vector<DNfaState>& states, std::string_view regex):
+                    _states(states),
+                    _regex(regex),
+                    _position(0)
+                {
+
+                }
+
+                /**
+                 * Returns the start and end states of the built fragment.
+                 */
+                constexpr std::pair<int, int> build() {
+                    auto fragment = this->_parseAlternation();
+                    if (this->_position != this->_regex.size()) {
+                        throw std::invalid_argument("Unbalanced parenthesis in regular expression.");
+                    }
+                    return fragment;
+                }
+
+            private:
+                std::vector<DNfaState>& _states;
+                std::string_view _regex;
+                std::size_t _position;
+                /**
+                 * The byte of the last parsed escape, or -1 if it was a class like \s.
+                 */
+                int _escapedByte = -1;
+
+                constexpr int _newState() {
+                    this->_states.push_back(DNfaState{});
+                    return (int) this->_states.size() - 1;
+                }
+
+                constexpr bool _atEnd() {
+                    return this->_position >= this->_regex.size();
+                }
+
+                constexpr int _peek() {
+                    return (unsigned char) this->_regex[this->_position];
+                }
+
+                constexpr std::pair<int, int> _parseAlternation() {
+                    auto fragment = this->_parseConcatenation();
+                    while (!this->_atEnd() && this->_peek() == '|') {
+                        this->_position++;
+                        auto alternative = this->_parseConcatenation();
+                        int start = this->_newState();
+                        int end = this->_newState();
+                        this->_states[start].next = fragment.first;
+                        this->_states[start].alternative = alternative.first;
+                        this->_states[fragment.second].next = end;
+                        this->_states[alternative.second].next = end;
+                        fragment = {start, end};
+                    }
+                    return fragment;
+                }
+
+                constexpr std::pair<int, int> _parseConcatenation() {
+                    int start = this->_newState();
+                    std::pair<int, int> fragment {start, start};
+                    while (!this->_atEnd() && this->_peek() != '|' && this->_peek() != ')') {
+                        auto part = this->_parseRepetition();
+                        this->_states[fragment.second].next = part.first;
+                        fragment.second = part.second;
+                    }
+                    return fragment;
+                }
+
+                constexpr std::pair<int, int> _parseRepetition() {
+                    auto fragment = this->_parseAtom();
+                    while (!this->_atEnd()) {
+                        int quantifier = this->_peek();
+                        if (quantifier == '{') {
+                            throw UnsupportedRegex("Bounded repetition is not supported.");
+                        }
+                        if (quantifier != '*' && quantifier != '+' && quantifier != '?') {
+                            break;
+                        }
+                        this->_position++;
+                        if (!this->_atEnd() && this->_peek() == '?') {
+                            throw UnsupportedRegex("Lazy quantifiers are not supported.");
+                        }
+                        int end = this->_newState();
+                        if (quantifier == '+') {
+                            this->_states[fragment.second].next = fragment.first;
+                            this->_states[fragment.second].alternative = end;
+                            fragment.second = end;
+                        } else {
+                            int start = this->_newState();
+                            this->_states[start].next = fragment.first;
+                            this->_states[start].alternative = end;
+                            this->_states[fragment.second].next = (quantifier == '*' ? fragment.first : end);
+                            if (quantifier == '*') {
+                                this->_states[fragment.second].alternative = end;
+                            }
+                            fragment = {start, end};
+                        }
+                    }
+                    return fragment;
+                }
+
+                constexpr std::pair<int, int> _parseAtom() {
+                    int character = this->_peek();
+                    this->_position++;
+                    TByteSet bytes {};
+                    if (character == '(') {
+                        if (!this->_atEnd() && this->_peek() == '?') {
+                            if (this->_position + 1 < this->_regex.size() && this->_regex[this->_position + 1] == ':') {
+                                this->_position += 2;
+                            } else {
+                                throw UnsupportedRegex("Lookarounds are not supported.");
+                            }
+                        }
+                        auto group = this->_parseAlternation();
+                        if (this->_atEnd() || this->_peek() != ')') {
+                            throw std::invalid_argument("Unbalanced parenthesis in regular expression.");
+                        }
+                        this->_position++;
+                        return group;
+                    } else if (character == '[') {
+                        bytes = this->_parseClass();
+                    } else if (character == '.') {
+                        // ECMAScript '.' matches anything but line terminators.
+                        addByte(bytes, '\n');
+                        addByte(bytes, '\r');
+                        bytes = complement(bytes);
+                    } else if (character == '\\') {
+                        bytes = this->_parseEscape();
+                    } else if (character == '^' || character == '$' || character == '{' || character == '}') {
+                        throw UnsupportedRegex("Anchors and braces are not supported.");
+                    } else if (character == '*' || character == '+' || character == '?' || character == ')') {
+                        throw std::invalid_argument("Unexpected character in regular expression.");
+                    } else {
+                        addByte(bytes, character);
+                    }
+                    int start = this->_newState();
+                    int end = this->_newState();
+                    this->_states[start].consumes = true;
+                    this->_states[start].bytes = bytes;
+                    this->_states[start].next = end;
+                    return {start, end};
+                }
+
+                /**
+                 * Parses the escape following a backslash.
+                 */
+                constexpr TByteSet _parseEscape() {
+                    if (this->_atEnd()) {
+                        throw std::invalid_argument("Regular expression ends with a backslash.");
+                    }
+                    int character = this->_peek();
+                    this->_position++;
+                    TByteSet bytes {};
+                    this->_escapedByte = -1;
+                    switch (character) {
+                        case 'd': case 'D':
+                            addRange(bytes, '0', '9');
+                            break;
+                        case 'w': case 'W':
+                            addRange(bytes, 'a', 'z');
+                            addRange(bytes, 'A', 'Z');
+                            addRange(bytes, '0', '9');
+                            addByte(bytes, '_');
+                            break;
+                        case 's': case 'S':
+                            addRange(bytes, '\t', '\r');
+                            addByte(bytes, ' ');
+                            break;
+                        case 'n': this->_escapedByte = '\n'; break;
+                        case 't': this->_escapedByte = '\t'; break;
+                        case 'r': this->_escapedByte = '\r'; break;
+                        case 'f': this->_escapedByte = '\f'; break;
+                        case 'v': this->_escapedByte = '\v'; break;
+                        case '0': this->_escapedByte = '\0'; break;
+                        default:
+                            if ((character >= 'a' && character <= 'z') ||
+                                (character >= 'A' && character <= 'Z') ||
+                                (character >= '1' && character <= '9')) {
+                                throw UnsupportedRegex("Unsupported escape in regular expression.");
+                            }
+                            this->_escapedByte = character;
+                    }
+                    if (this->_escapedByte != -1) {
+                        addByte(bytes, this->_escapedByte);
+                    } else if (character == 'D' || character == 'W' || character == 'S') {
+                        bytes = complement(bytes);
+                    }
+                    return bytes;
+                }
+
+                /**
+                 * Parses a bracketed character class after the opening bracket.
+                 */
+                constexpr TByteSet _parseClass() {
+                    TByteSet bytes {};
+                    bool negated = !this->_atEnd() && this->_peek() == '^';
+                    if (negated) {
+                        this->_position++;
+                    }
+                    while (!this->_atEnd() && this->_peek() != ']') {
+                        int from = this->_parseClassMember(bytes);
+                        if (from == -1) {
+                            continue;
+                        }
+                        bool isRange = (
+                            this->_position + 1 < this->_regex.size() &&
+                            this->_peek() == '-' &&
+                            this->_regex[this->_position + 1] != ']'
+                        );
+                        if (isRange) {
+                            this->_position++;
+                            int to = this->_parseClassMember(bytes);
+                            if (to == -1 || to < from) {
+                                throw std::invalid_argument("Invalid range in character class.");
+                            }
+                            addRange(bytes, from, to);
+                        } else {
+                            addByte(bytes, from);
+                        }
+                    }
+                    if (this->_atEnd()) {
+                        throw std::invalid_argument("Unterminated character class.");
+                    }
+                    this->_position++;
+                    return negated ? complement(bytes) : bytes;
+                }
+
+                /**
+                 * Parses one member of a character class. Returns its byte, or -1
+                 * if the member was a class escape, which is then added directly.
+                 */
+                constexpr int _parseClassMember(TByteSet& bytes) {
+                    int character = this->_peek();
+                    this->_position++;
+                    if (character != '\\') {
+                        return character;
+                    }
+                    if (!this->_atEnd() && this->_peek() == 'b') {
+                        throw UnsupportedRegex("Backspace escapes are not supported.");
+                    }
+                    auto escaped = this->_parseEscape();
+                    if (this->_escapedByte == -1) {
+                        addSet(bytes, escaped);
+                    }
+                    return this->_escapedByte;
+                }
+        };
+
+        /**
+         * A set of NFA states as a bitset.
+         */
+        using TStateSet = std::vector<std::uint64_t>;
+
+        constexpr void addState(TStateSet& set, int state) {
+            set[state >> 6] |= std::uint64_t{1} << (state & 63);
+        }
+
+        constexpr bool hasState(const TStateSet& set, int state) {
+            return (set[state >> 6] >> (state & 63)) & 1;
+        }
+
+        constexpr bool isEmpty(const TStateSet& set) {
+            for (auto word : set) {
+                if (word != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Extends the set with every state reachable from it without consuming input.
+         */
+        constexpr void close(const std::vector<DNfaState>& states, TStateSet& set) {
+            std::vector<int> pending {};
+            for (int state = 0; state < (int) states.size(); state++) {
+                if (hasState(set, state)) {
+                    pending.push_back(state);
+                }
+            }
+            while (!pending.empty()) {
+                int state = pending.back();
+                pending.pop_back();
+                if (states[state].consumes) {
+                    continue;
+                }
+                for (int target : {states[state].next, states[state].alternative}) {
+                    if (target != -1 && !hasState(set, target)) {
+                        addState(set, target);
+                        pending.push_back(target);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Assigns each byte to an equivalence class such that bytes in the
+         * same class are accepted by exactly the same consuming states. Returns
+         * the amount of classes and fills in a representative byte of each class.
+         */
+        constexpr int classifyBytes(
+            const std::vector<DNfaState>& states,
+            std::array<int, 256>& byteClasses,
+            std::vector<int>& representatives
+        ) {
+            // The signature of a byte is the set of consuming states that accept it.
+            auto emptySet = TStateSet((states.size() + 63) / 64, 0);
+            std::vector<TStateSet> signatures(256, emptySet);
+            for (int state = 0; state < (int) states.size(); state++) {
+                if (states[state].consumes) {
+                    for (int byte = 0; byte < 256; byte++) {
+                        if (hasByte(states[state].bytes, byte)) {
+                            addState(signatures[byte], state);
+                        }
+                    }
+                }
+            }
+            for (int byte = 0; byte < 256; byte++) {
+                byteClasses[byte] = -1;
+                for (int i = 0; i < (int) representatives.size() && byteClasses[byte] == -1; i++) {
+                    if (signatures[byte] == signatures[representatives[i]]) {
+                        byteClasses[byte] = i;
+                    }
+                }
+                if (byteClasses[byte] == -1) {
+                    byteClasses[byte] = (int) representatives.size();
+                    representatives.push_back(byte);
+                }
+            }
+            return (int) representatives.size();
+        }
+
+        /**
+         * Merges equivalent states of the automaton with Moore's partition refinement.
+         */
+        constexpr DAutomaton minimize(const DAutomaton& automaton) {
+            int stateCount = (int) automaton.acceptingRules.size();
+            int classCount = automaton.classCount;
+            // Initially states are only distinguished by the rule they accept.
+            std::vector<int> partition(stateCount);
+            std::vector<int> partitionRules {};
+            for (int state = 0; state < stateCount; state++) {
+                int block = 0;
+                while (block < (int) partitionRules.size() && partitionRules[block] != automaton.acceptingRules[state]) {
+                    block++;
+                }
+                if (block == (int) partitionRules.size()) {
+                    partitionRules.push_back(automaton.acceptingRules[state]);
+                }
+                partition[state] = block;
+            }
+            int blockCount = (int) partitionRules.size();
+            // Split blocks until states in the same block agree on the blocks of their targets.
+            while (true) {
+                std::vector<std::vector<int>> signatures {};
+                std::vector<int> refined(stateCount);
+                for (int state = 0; state < stateCount; state++) {
+                    std::vector<int> signature {partition[state]};
+                    for (int byteClass = 0; byteClass < classCount; byteClass++) {
+                        int target = automaton.transitions[state * classCount + byteClass];
+                        signature.push_back(target == -1 ? -1 : partition[target]);
+                    }
+                    int block = 0;
+                    while (block < (int) signatures.size() && signatures[block] != signature) {
+                        block++;
+                    }
+                    if (block == (int) signatures.size()) {
+                        signatures.push_back(signature);
+                    }
+                    refined[state] = block;
+                }
+                partition = refined;
+                if ((int) signatures.size() == blockCount) {
+                    break;
+                }
+                blockCount = (int) signatures.size();
+            }
+            DAutomaton minimized {};
+            minimized.byteClasses = automaton.byteClasses;
+            minimized.classCount = classCount;
+            minimized.startState = partition[automaton.startState];
+            minimized.transitions = std::vector<int>(blockCount * classCount, -1);
+            minimized.acceptingRules = std::vector<int>(blockCount, -1);
+            for (int state = 0; state < stateCount; state++) {
+                int block = partition[state];
+                minimized.acceptingRules[block] = automaton.acceptingRules[state];
+                for (int byteClass = 0; byteClass < classCount; byteClass++) {
+                    int target = automaton.transitions[state * classCount + byteClass];
+                    minimized.transitions[block * classCount + byteClass] = (target == -1 ? -1 : partition[target]);
+                }
+            }
+            return minimized;
+        }
+
+        /**
+         * Compiles the given regular expressions into a minimized automaton
+         * whose accepting states report the index of the matched expression.
+         */
+        template <typename TRegexes>
+        constexpr DAutomaton compile(const TRegexes& regexes) {
+            // Build one NFA where the start state branches into every rule.
+            std::vector<DNfaState> states {DNfaState{}};
+            int branch = 0;
+            int rule = 0;
+            for (std::string_view regex : regexes) {
+                auto fragment = NfaBuilder(states, regex).build();
+                states[fragment.second].rule = rule;
+                int nextBranch = (int) states.size();
+                states.push_back(DNfaState{});
+                states[branch].next = fragment.first;
+                states[branch].alternative = nextBranch;
+                branch = nextBranch;
+                rule++;
+            }
+
+            DAutomaton automaton {};
+            std::vector<int> representatives {};
+            automaton.classCount = classifyBytes(states, automaton.byteClasses, representatives);
+
+            // The consuming states that accept each byte class, along with the state they move to.
+            std::vector<std::vector<std::pair<int, int>>> consumers(automaton.classCount);
+            for (int state = 0; state < (int) states.size(); state++) {
+                for (int byteClass = 0; byteClass < automaton.classCount && states[state].consumes; byteClass++) {
+                    if (hasByte(states[state].bytes, representatives[byteClass])) {
+                        consumers[byteClass].push_back({state, states[state].next});
+                    }
+                }
+            }
+
+            // Subset construction, where each deterministic state is a set of NFA states.
+            auto emptySet = TStateSet((states.size() + 63) / 64, 0);
+            std::vector<TStateSet> subsets {emptySet};
+            addState(subsets[0], 0);
+            close(states, subsets[0]);
+            automaton.startState = 0;
+            for (int subset = 0; subset < (int) subsets.size(); subset++) {
+                int acceptedRule = -1;
+                for (int state = 0; state < (int) states.size(); state++) {
+                    int stateRule = states[state].rule;
+                    if (stateRule != -1 && hasState(subsets[subset], state) && (acceptedRule == -1 || stateRule < acceptedRule)) {
+                        acceptedRule = stateRule;
+                    }
+                }
+                automaton.acceptingRules.push_back(acceptedRule);
+                for (int byteClass = 0; byteClass < automaton.classCount; byteClass++) {
+                    auto moved = emptySet;
+                    for (auto [state, next] : consumers[byteClass]) {
+                        if (hasState(subsets[subset], state)) {
+                            addState(moved, next);
+                        }
+                    }
+                    if (isEmpty(moved)) {
+                        automaton.transitions.push_back(-1);
+                        continue;
+                    }
+                    close(states, moved);
+                    int target = 0;
+                    while (target < (int) subsets.size() && subsets[target] != moved) {
+                        target++;
+                    }
+                    if (target == (int) subsets.size()) {
+                        subsets.push_back(moved);
+                    }
+                    automaton.transitions.push_back(target);
+                }
+            }
+            return minimize(automaton);
+        }
+    };
+};
+
+#endif
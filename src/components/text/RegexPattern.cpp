@@ -5,17 +5,31 @@ RegexPattern::RegexPattern(std::string regex):
     regex(
         regex,
         std::regex_constants::ECMAScript
-    )
+    ),
+    _automaton(nullptr)
 {
-    
+    if (Text::RegexAutomaton::supports(regex)) {
+        this->_automaton = std::make_shared<Text::RegexAutomaton>(std::vector<std::string>{regex});
+    }
 }
 
-std::pair<int, std::string> RegexPattern::recognize(std::string text) {
-    std::smatch match;
-    auto found = std::regex_search(text, match, this->regex);
-    if (found) {
-        return std::pair<int, std::string>(match.position(0), match[0]);
-    } else {
-        return std::pair<int, std::string>(-1, "");
+int RegexPattern::recognizeAt(std::string_view source, std::size_t offset) {
+    if (this->_automaton != nullptr) {
+        auto match = this->_automaton->match(source, offset);
+        return match.first == -1 ? -1 : match.second;
+    }
+    // Only allow the match to start at the offset, while still letting 
+    // assertions like ^ see the text before it.
+    auto flags = std::regex_constants::match_continuous;
+    if (offset > 0) {
+        flags |= std::regex_constants::match_prev_avail;
     }
-}
\ No newline at end of file
+    auto found = std::regex_search(
+        source.data() + offset, 
+        source.data() + source.size(), 
+        this->_match, 
+        this->regex, 
+        flags
+    );
+    return found ? (int) this->_match.length(0) : -1;
+}
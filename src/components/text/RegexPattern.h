@@ -2,14 +2,26 @@
 #define TEXT_REGEXPATTERN_HH
 
 #include <string>
+#include <string_view>
 #include <regex>
+#include <memory>
 #include "ITextPattern.h"
+#include "RegexAutomaton.h"
 
+/**
+ * A pattern given by a regular expression. Expressions the automaton 
+ * supports are matched with it, finding the longest match without 
+ * allocating. Other expressions fall back to std::regex, which finds 
+ * the first match in ECMAScript alternation order.
+ */
 class RegexPattern: public ITextPattern {
     public:
         std::regex regex;
         RegexPattern(std::string regex);
-        std::pair<int, std::string> recognize(std::string text) override;
+        int recognizeAt(std::string_view source, std::size_t offset) override;
+    private:
+        std::shared_ptr<Text::RegexAutomaton> _automaton;
+        std::cmatch _match;
 };
 
-#endif
\ No newline at end of file
+#endif
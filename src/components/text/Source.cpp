@@ -0,0 +1,111 @@
+#include "Source.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+    #include <fstream>
+    #include <sstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+Text::Source::Source(std::string text):
+    _storage(std::move(text)),
+    _mapping(nullptr),
+    _mappingSize(0),
+    _text(this->_storage)
+{
+
+}
+
+Text::Source::Source(const char* mapping, std::size_t mappingSize):
+    _storage(),
+    _mapping(mapping),
+    _mappingSize(mappingSize),
+    _text(mapping, mappingSize)
+{
+
+}
+
+Text::Source::~Source() {
+    #ifndef _WIN32
+        if (this->_mapping != nullptr) {
+            munmap((void*) this->_mapping, this->_mappingSize);
+        }
+    #endif
+}
+
+std::unique_ptr<Text::Source> Text::Source::map(std::string path) {
+    #ifdef _WIN32
+        auto file = std::ifstream{path, std::ios::binary};
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file '" + path + "'.");
+        }
+        auto text = std::ostringstream{};
+        text << file.rdbuf();
+        return std::unique_ptr<Source>(new Source{text.str()});
+    #else
+        int file = open(path.c_str(), O_RDONLY);
+        struct stat status;
+        if (file == -1 || fstat(file, &status) == -1) {
+            if (file != -1) {
+                close(file);
+            }
+            throw std::runtime_error("Could not open file '" + path + "'.");
+        }
+        // Empty files cannot be mapped, but have nothing to read either.
+        if (status.st_size == 0) {
+            close(file);
+            return std::unique_ptr<Source>(new Source{std::string{}});
+        }
+        auto size = (std::size_t) status.st_size;
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        // The mapping stays valid after the file is closed.
+        close(file);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Could not map file '" + path + "'.");
+        }
+        // Tokens are read front to back.
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        return std::unique_ptr<Source>(new Source{(const char*) mapping, size});
+    #endif
+}
+
+std::string_view Text::Source::text() const {
+    return this->_text;
+}
+
+int Text::Source::size() const {
+    return (int) this->_text.size();
+}
+
+Text::Location Text::Source::location(int positionIndex) const {
+    std::call_once(this->_lineStartsBuilt, [this]() { this->_buildLineStarts(); });
+    // The character at the position itself counts as passed, like 
+    // in the Location constructor that counts from an iterator. Thus, 
+    // a newline at the position already belongs to the previous lines.
+    auto nextLine = std::upper_bound(
+        this->_lineStarts.begin(), 
+        this->_lineStarts.end(), 
+        (std::uint32_t) positionIndex + 1
+    );
+    int newLines = (int) (nextLine - this->_lineStarts.begin()) - 1;
+    int lastNewLineIndex = newLines > 0 ? (int) this->_lineStarts.at(newLines) - 1 : 0;
+    return Location{positionIndex, 1 + newLines, positionIndex - lastNewLineIndex + 1};
+}
+
+void Text::Source::_buildLineStarts() const {
+    this->_lineStarts.push_back(0);
+    // memchr scans many bytes at a time, which is much faster 
+    // than comparing characters one by one.
+    const char* start = this->_text.data();
+    const char* end = start + this->_text.size();
+    const char* newLine = start;
+    while ((newLine = (const char*) std::memchr(newLine, '\n', end - newLine)) != nullptr) {
+        newLine++;
+        this->_lineStarts.push_back((std::uint32_t) (newLine - start));
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef TEXT_SOURCE_HH
+#define TEXT_SOURCE_HH
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Location.h"
+
+namespace Text {
+    /**
+     * An immutable text buffer that tokens and other views refer into. 
+     * Since views hold on to the buffer by address, a Source can be 
+     * neither copied nor moved. The text is either owned or a read-only 
+     * mapping of a file.
+     */
+    class Source {
+        public:
+            Source(std::string text);
+            Source(const Source&) = delete;
+            Source& operator=(const Source&) = delete;
+            ~Source();
+            /**
+             * Creates a source from the contents of the file at the given path. The 
+             * file is memory-mapped, so its text is only read in as it is accessed.
+             */
+            static std::unique_ptr<Source> map(std::string path);
+            std::string_view text() const;
+            int size() const;
+            /**
+             * Returns the line and column of the given position in the text. 
+             * Takes logarithmic time in the amount of lines.
+             */
+            Location location(int positionIndex) const;
+        private:
+            std::string _storage;
+            const char* _mapping;
+            std::size_t _mappingSize;
+            std::string_view _text;
+            /**
+             * The index at which each line starts. Built on the first 
+             * location request, since most sources never need one.
+             */
+            mutable std::vector<std::uint32_t> _lineStarts;
+            mutable std::once_flag _lineStartsBuilt;
+            Source(const char* mapping, std::size_t mappingSize);
+            void _buildLineStarts() const;
+    };
+};
+
+#endif
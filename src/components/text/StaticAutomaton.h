@@ -0,0 +1,81 @@
+#ifndef TEXT_STATICAUTOMATON_HH
+#define TEXT_STATICAUTOMATON_HH
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include "DAutomaton.h"
+#include "RegexCompiler.h"
+
+namespace Text {
+    /**
+     * The tables of a deterministic automaton stored in fixed size arrays, so
+     * that an automaton compiled at compile time can live in a constant.
+     */
+    template<int States, int Classes>
+    struct StaticAutomaton {
+        std::array<int, 256> byteClasses {};
+        int startState = 0;
+        std::array<int, States * Classes> transitions {};
+        std::array<int, States> acceptingRules {};
+
+        /**
+         * Returns the index of the matched expression and the length of the
+         * longest match at the given offset, or the pair (-1, 0) if nothing matches.
+         */
+        constexpr std::pair<int, int> match(std::string_view text, std::size_t offset) const {
+            int state = this->startState;
+            std::pair<int, int> longest {this->acceptingRules[state], 0};
+            for (std::size_t position = offset; position < text.size(); position++) {
+                state = this->transitions[state * Classes + this->byteClasses[(unsigned char) text[position]]];
+                if (state == -1) {
+                    break;
+                }
+                if (this->acceptingRules[state] != -1) {
+                    longest = {this->acceptingRules[state], (int) (position - offset + 1)};
+                }
+            }
+            return longest;
+        }
+
+        /**
+         * Copies the tables into a DAutomaton for the runtime matcher.
+         */
+        DAutomaton automaton() const {
+            auto automaton = DAutomaton{};
+            automaton.byteClasses = this->byteClasses;
+            automaton.classCount = Classes;
+            automaton.startState = this->startState;
+            automaton.transitions.assign(this->transitions.begin(), this->transitions.end());
+            automaton.acceptingRules.assign(this->acceptingRules.begin(), this->acceptingRules.end());
+            return automaton;
+        }
+    };
+
+    /**
+     * Compiles the given constant list of regular expressions into a StaticAutomaton.
+     * The expressions are compiled once to learn the size of the tables and once
+     * more to fill them, both times at compile time.
+     */
+    template<const auto& Regexes>
+    constexpr auto compileStatic() {
+        constexpr auto size = []() {
+            auto automaton = RegexCompiler::compile(Regexes);
+            return std::pair<int, int>{(int) automaton.acceptingRules.size(), automaton.classCount};
+        }();
+        auto compiled = RegexCompiler::compile(Regexes);
+        auto result = StaticAutomaton<size.first, size.second>{};
+        result.byteClasses = compiled.byteClasses;
+        result.startState = compiled.startState;
+        for (int i = 0; i < (int) compiled.transitions.size(); i++) {
+            result.transitions[i] = compiled.transitions[i];
+        }
+        for (int i = 0; i < (int) compiled.acceptingRules.size(); i++) {
+            result.acceptingRules[i] = compiled.acceptingRules[i];
+        }
+        return result;
+    }
+};
+
+#endif
@@ -1,17 +1,49 @@
 #ifndef TOKENIZATION_DTOKEN_HH
 #define TOKENIZATION_DTOKEN_HH
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "Symbols.h"
 #include "../text/Location.h"
+#include "../text/Source.h"
 
-// The data of a Token detected during tokenization.
+// The data of a Token detected during tokenization. The token does not 
+// own its text but refers to a span of the source it was found in.
 struct DToken {
-    std::string type;
-    std::string value;
-    int startPos;
-    int endPos;
-    Text::Location startLocation {};
-    Text::Location endLocation {};
+    int kind;
+    /**
+     * The interned id of the token's value when the value is a fixed spelling 
+     * of its pattern, such as a keyword or an operator. Otherwise -1.
+     */
+    int symbol;
+    std::uint32_t offset;
+    std::uint32_t length;
+    const Text::Source* source;
+
+    std::string_view value() const {
+        return this->source->text().substr(this->offset, this->length);
+    }
+
+    const std::string& type() const {
+        return Tokenization::Symbols::name(this->kind);
+    }
+
+    int startPos() const {
+        return (int) this->offset;
+    }
+
+    int endPos() const {
+        return (int) (this->offset + this->length);
+    }
+
+    Text::Location startLocation() const {
+        return this->source->location(this->startPos());
+    }
+
+    Text::Location endLocation() const {
+        return this->source->location(this->endPos());
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,109 @@
+#ifndef TOKENIZATION_KEYWORD_TABLE_HH
+#define TOKENIZATION_KEYWORD_TABLE_HH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace Tokenization {
+    /**
+     * A word that is lexed like an identifier but has a token kind of its own.
+     */
+    struct Keyword {
+        std::string_view spelling;
+        std::string_view kind;
+    };
+
+    /**
+     * The hash of a word in a keyword table. FNV-1a, starting from 
+     * the seed instead of the usual offset basis.
+     */
+    constexpr std::uint32_t keywordHash(std::string_view word, std::uint32_t seed) {
+        std::uint32_t hash = seed;
+        for (char c : word) {
+            hash = (hash ^ (unsigned char) c) * 16777619u;
+        }
+        return hash ^ (hash >> 15);
+    }
+
+    /**
+     * A perfect hash table of keywords, built at compile time. The hash seed is 
+     * searched for until every keyword has a slot of its own, so finding out whether 
+     * a word is a keyword takes one hash and at most one comparison.
+     */
+    template<std::size_t N>
+    class KeywordTable {
+        public:
+            /**
+             * The amount of slots in the table, the smallest power of two 
+             * that is at least twice the amount of keywords.
+             */
+            static constexpr std::size_t slotCount = []() {
+                std::size_t count = 1;
+                while (count < 2 * N) {
+                    count = count * 2;
+                }
+                return count;
+            }();
+
+            constexpr KeywordTable(std::array<Keyword, N> keywords):
+                _keywords(keywords), _seed(0), _slots{}
+            {
+                for (std::uint32_t seed = 1; seed < maxSeed; seed++) {
+                    if (this->_fillSlots(seed)) {
+                        this->_seed = seed;
+                        return;
+                    }
+                }
+                throw std::logic_error("No perfect hash found for the keywords.");
+            }
+
+            /**
+             * Returns the index of the keyword with the given spelling, or -1 if there is none.
+             */
+            constexpr int find(std::string_view word) const {
+                int index = this->_slots[keywordHash(word, this->_seed) & (slotCount - 1)];
+                return (index != -1 && this->_keywords[index].spelling == word) ? index : -1;
+            }
+
+            constexpr const Keyword& at(std::size_t index) const {
+                return this->_keywords[index];
+            }
+
+            static constexpr std::size_t size() {
+                return N;
+            }
+
+            constexpr std::uint32_t seed() const {
+                return this->_seed;
+            }
+
+            /**
+             * The index of the keyword in the given slot, or -1 if the slot is empty.
+             */
+            constexpr int slot(std::size_t index) const {
+                return this->_slots[index];
+            }
+        private:
+            static constexpr std::uint32_t maxSeed = 1 << 16;
+            std::array<Keyword, N> _keywords;
+            std::uint32_t _seed;
+            std::array<int, slotCount> _slots;
+
+            constexpr bool _fillSlots(std::uint32_t seed) {
+                this->_slots.fill(-1);
+                for (std::size_t i = 0; i < N; i++) {
+                    auto& slot = this->_slots[keywordHash(this->_keywords[i].spelling, seed) & (slotCount - 1)];
+                    if (slot != -1) {
+                        return false;
+                    }
+                    slot = (int) i;
+                }
+                return true;
+            }
+    };
+};
+
+#endif
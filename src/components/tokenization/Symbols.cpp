@@ -0,0 +1,44 @@
+#include "Symbols.h"
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace {
+    // Names are kept in a deque so that references to them stay valid as symbols are added.
+    struct DSymbolTable {
+        std::mutex mutex;
+        std::deque<std::string> names {"end"};
+        std::map<std::string, int, std::less<>> ids {{"end", Tokenization::Symbols::end}};
+    };
+
+    DSymbolTable& symbolTable() {
+        static DSymbolTable table;
+        return table;
+    }
+}
+
+int Tokenization::Symbols::id(std::string_view name) {
+    auto& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto existing = table.ids.find(name);
+    if (existing != table.ids.end()) {
+        return existing->second;
+    }
+    int id = (int) table.names.size();
+    table.names.emplace_back(name);
+    table.ids.emplace(table.names.back(), id);
+    return id;
+}
+
+int Tokenization::Symbols::find(std::string_view name) {
+    auto& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto existing = table.ids.find(name);
+    return existing != table.ids.end() ? existing->second : -1;
+}
+
+const std::string& Tokenization::Symbols::name(int id) {
+    auto& table = symbolTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.names.at(id);
+}
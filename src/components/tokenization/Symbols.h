@@ -0,0 +1,33 @@
+#ifndef TOKENIZATION_SYMBOLS_HH
+#define TOKENIZATION_SYMBOLS_HH
+
+#include <string>
+#include <string_view>
+
+namespace Tokenization {
+    /**
+     * Interns token kind names and the fixed spellings of tokens (keywords, 
+     * operators and punctuation) into integer ids shared by the whole program. 
+     * Both live in the same id space, so a parser rule named by a string can 
+     * be matched against either the kind or the value of a token with integer 
+     * comparisons only.
+     */
+    class Symbols {
+        public:
+            /**
+             * The kind of the token that ends every token sequence.
+             */
+            static constexpr int end = 0;
+            /**
+             * Returns the id of the symbol with the given name, adding the symbol if it is new.
+             */
+            static int id(std::string_view name);
+            /**
+             * Returns the id of the symbol with the given name, or -1 if there is no such symbol.
+             */
+            static int find(std::string_view name);
+            static const std::string& name(int id);
+    };
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef TOKENIZATION_TOKENSPECIFICATION_HH
+#define TOKENIZATION_TOKENSPECIFICATION_HH
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "../text/StaticAutomaton.h"
+
+namespace Tokenization {
+    /**
+     * A token pattern of a specification: the kind of the tokens and the
+     * regular expression recognizing them.
+     */
+    struct TokenRule {
+        std::string_view kind;
+        std::string_view regex;
+    };
+
+    /**
+     * A token grammar that is fixed at build time. The rules are compiled into
+     * the automaton of a Tokenizer while compiling, so that adding them to a
+     * tokenizer does not have to parse or compile any regular expression.
+     *
+     * Rules have the same priorities as patterns added one at a time: the longest
+     * match wins and equally long matches go to the earliest rule. Rules whose
+     * expression only matches a literal give their tokens the symbol of that literal.
+     */
+    template<const auto& Rules>
+    class TokenSpecification {
+        public:
+            static constexpr std::size_t size = Rules.size();
+            static constexpr auto regexes = []() {
+                auto regexes = std::array<std::string_view, size>{};
+                for (std::size_t i = 0; i < size; i++) {
+                    regexes[i] = Rules[i].regex;
+                }
+                return regexes;
+            }();
+            static constexpr auto automaton = Text::compileStatic<regexes>();
+
+            static constexpr const TokenRule& at(std::size_t rule) {
+                return Rules[rule];
+            }
+
+            /**
+             * The index of the first rule of the given kind, or -1 if there is none.
+             */
+            static constexpr int ruleOf(std::string_view kind) {
+                for (std::size_t i = 0; i < size; i++) {
+                    if (Rules[i].kind == kind) {
+                        return (int) i;
+                    }
+                }
+                return -1;
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include "TokenStream.h"
+#include <limits>
+#include <stdexcept>
+
+Tokenization::TokenStream::TokenStream(Tokenizer& tokenizer, const Text::Source& source):
+    _tokenizer(tokenizer),
+    _source(source),
+    _position(0),
+    _finished(false),
+    _commentKind(Symbols::id("comment")),
+    _whitespaceKind(Symbols::id("whitespace"))
+{
+    if (source.text().size() >= (size_t) std::numeric_limits<int>::max()) {
+        throw std::runtime_error("The text is too large to tokenize.");
+    }
+}
+
+DToken Tokenization::TokenStream::next() {
+    while (true) {
+        // If we have reached the end of the text, we yield the end token.
+        if (this->_position == this->_source.size()) {
+            this->_finished = true;
+            return DToken{Symbols::end, -1, (std::uint32_t) this->_position, 0, &(this->_source)};
+        }
+        auto token = this->_tokenizer.recognizeToken(this->_source, this->_position);
+        this->_position = token.endPos();
+        // Comments and whitespace are skipped, since we do not care about these.
+        if (token.kind != this->_commentKind && token.kind != this->_whitespaceKind) {
+            return token;
+        }
+    }
+}
+
+bool Tokenization::TokenStream::finished() const {
+    return this->_finished;
+}
@@ -0,0 +1,36 @@
+#ifndef TOKENIZATION_TOKEN_STREAM_HH
+#define TOKENIZATION_TOKEN_STREAM_HH
+
+#include "DToken.h"
+#include "Tokenization.h"
+#include "../text/Source.h"
+
+namespace Tokenization {
+    /**
+     * Tokenizes a source on demand, one token at a time, so that tokens 
+     * can be consumed before the rest of the source has been tokenized. 
+     * Comments and whitespace are skipped, and the last token is the end token.
+     */
+    class TokenStream {
+        public:
+            TokenStream(Tokenizer& tokenizer, const Text::Source& source);
+            /**
+             * Returns the next token. Once the end token has been 
+             * returned, keeps returning it.
+             */
+            DToken next();
+            /**
+             * Whether the end token has been returned.
+             */
+            bool finished() const;
+        private:
+            Tokenizer& _tokenizer;
+            const Text::Source& _source;
+            int _position;
+            bool _finished;
+            int _commentKind;
+            int _whitespaceKind;
+    };
+}
+
+#endif
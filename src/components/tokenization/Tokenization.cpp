@@ -1,95 +1,197 @@
 #include "Tokenization.h"
+#include "TokenStream.h"
 #include <string>
 #include <iostream>
 #include <regex>
 #include <string_view>
 #include <stdexcept>
+#include <cctype>
+
+namespace {
+    // The most spellings a pattern may have for them to be interned.
+    const int maxSpellings = 64;
+
+    // Returns a regular expression that matches exactly the given text.
+    std::string literalRegex(const std::string& text) {
+        auto regex = std::string{};
+        for (char c : text) {
+            if (!std::isalnum((unsigned char) c)) {
+                regex.push_back('\\');
+            }
+            regex.push_back(c);
+        }
+        return regex;
+    }
+
+    // Finds the text a regular expression matches if it only matches one 
+    // literal, made of plain and escaped characters and single character classes.
+    bool literalSpelling(std::string_view regex, std::string& spelling) {
+        spelling.clear();
+        for (std::size_t i = 0; i < regex.size(); i++) {
+            char c = regex[i];
+            if (c == '\\' && i + 1 < regex.size() && !std::isalnum((unsigned char) regex[i + 1])) {
+                spelling.push_back(regex[++i]);
+            } else if (c == '[' && i + 2 < regex.size() && regex[i + 1] != '^' && regex[i + 1] != '\\' && regex[i + 2] == ']') {
+                spelling.push_back(regex[i + 1]);
+                i += 2;
+            } else if (std::string_view{"\\.()[]{}|*+?^$"}.find(c) == std::string_view::npos) {
+                spelling.push_back(c);
+            } else {
+                return false;
+            }
+        }
+        return !spelling.empty();
+    }
+}
 
 Tokenization::Tokenizer::Tokenizer():
-    _patterns(std::vector<std::shared_ptr<TokenPattern>>{})
+    _patterns(std::vector<std::shared_ptr<TokenPattern>>{}),
+    _kinds(std::vector<int>{}),
+    _regexes(std::vector<std::string>{}),
+    _spellings(std::vector<std::vector<std::string>>{}),
+    _rules(std::vector<std::pair<int, int>>{}),
+    _keywordType(-1),
+    _keywordSeed(0),
+    _keywordSlots(std::vector<int>{}),
+    _keywordSpellings(std::vector<std::string>{}),
+    _keywordRules(std::vector<std::pair<int, int>>{}),
+    _automaton(nullptr),
+    _automatonIsStale(false)
 {
 
 }
 
-DToken Tokenization::Tokenizer::recognizeToken(std::string text) {
-    // Find the first pattern that matches the beginning of the text.
-    auto pattern = std::find_if(this->_patterns.begin(), this->_patterns.end(), [&](auto& p) {
-        // Find a match in the text for the given token pattern.
-        auto match = p->second->recognize(text);
-        // If the match exists and is at the beginning of the text.
-        return (match.first == 0);
-    });
-
-    // If a matching pattern was found, return it.
-    if (pattern != this->_patterns.end()) {
-        // Get the match.
-        auto match = (*pattern)->second->recognize(text);
-        // Determine the start and end positions of the match.
-        int startPos = match.first;
-        int endPos = match.first + ((int) match.second.size());
-        // Create a new token object from the match.
-        DToken token{
-            (*pattern)->first, 
-            match.second, 
-            startPos,
-            endPos
-        };
-        return token;
+DToken Tokenization::Tokenizer::recognizeToken(const Text::Source& source, int position) {
+    if (this->_automatonIsStale) {
+        this->_buildAutomaton();
+    }
+    // Empty matches would never advance the tokenizer, so they do not count.
+    if (this->_automaton != nullptr) {
+        auto match = this->_automaton->match(source.text(), position);
+        if (match.first != -1 && match.second > 0) {
+            auto rule = this->_rules[match.first];
+            if (rule.first == this->_keywordType) {
+                rule = this->_keywordRule(rule, source.text().substr(position, match.second));
+            }
+            return DToken{rule.first, rule.second, (std::uint32_t) position, (std::uint32_t) match.second, &source};
+        }
     } else {
-        throw std::runtime_error("Error during tokenizing.");
+        // Some pattern is not supported by the automaton, so we have to 
+        // try each pattern in turn and keep the longest match.
+        std::pair<int, int> longest {-1, 0};
+        if (this->_patterns.size() != this->_regexes.size()) {
+            this->_buildPatterns();
+        }
+        for (int i = 0; i < (int) this->_patterns.size(); i++) {
+            int length = this->_patterns.at(i)->second->recognizeAt(source.text(), position);
+            if (length > longest.second) {
+                longest = {i, length};
+            }
+        }
+        if (longest.first != -1) {
+            // Only values of patterns with listed spellings have symbols.
+            bool hasSymbol = !this->_spellings.at(longest.first).empty();
+            auto word = source.text().substr(position, longest.second);
+            auto rule = std::pair<int, int>{this->_kinds.at(longest.first), hasSymbol ? Symbols::find(word) : -1};
+            if (rule.first == this->_keywordType) {
+                rule = this->_keywordRule(rule, word);
+            }
+            return DToken{rule.first, rule.second, (std::uint32_t) position, (std::uint32_t) longest.second, &source};
+        }
     }
+    throw std::runtime_error("Error during tokenizing.");
 }
 
-std::vector<DToken> Tokenization::Tokenizer::tokenize(std::string text) {
-    // List of found tokens in text.
+std::pair<int, int> Tokenization::Tokenizer::_keywordRule(std::pair<int, int> rule, std::string_view word) {
+    auto slot = keywordHash(word, this->_keywordSeed) & (this->_keywordSlots.size() - 1);
+    int keyword = this->_keywordSlots[slot];
+    return (keyword != -1 && this->_keywordSpellings[keyword] == word) ? this->_keywordRules[keyword] : rule;
+}
+
+std::vector<DToken> Tokenization::Tokenizer::tokenize(const Text::Source& source) {
+    auto stream = TokenStream{*this, source};
     auto tokens = std::vector<DToken>();
-    // Current position in text.
-    int pos = 0;
-    while (true) {
-        // If we have reached the end of the text.
-        if (pos == (int) (text.size())) {
-            // Add the end token.
-            DToken token {
-                "end", 
-                "", 
-                pos, 
-                pos,
-                Text::Location{pos, text.begin()},
-                Text::Location{pos, text.begin()}
-            };
-            tokens.insert(tokens.end(), token);
-            // Return from the loop.
-            break;
+    while (!stream.finished()) {
+        tokens.push_back(stream.next());
+    }
+    return tokens;
+}
+
+Tokenization::DTokenizedText Tokenization::Tokenizer::tokenize(std::string text) {
+    auto source = std::make_shared<const Text::Source>(std::move(text));
+    auto tokens = this->tokenize(*source);
+    return DTokenizedText{std::move(source), std::move(tokens)};
+}
+
+void Tokenization::Tokenizer::addRegexPattern(TToken type, std::string regex) {
+    this->_kinds.push_back(Symbols::id(type));
+    this->_regexes.push_back(regex);
+    // Intern the spellings of the pattern if it only has a few of them.
+    auto spellings = std::vector<std::string>{};
+    if (
+        !Text::RegexAutomaton::supports(regex) || 
+        !Text::RegexAutomaton(std::vector<std::string>{regex}).enumerate(spellings, maxSpellings)
+    ) {
+        spellings.clear();
+    }
+    for (auto& spelling : spellings) {
+        Symbols::id(spelling);
+    }
+    this->_spellings.push_back(spellings);
+    this->_automatonIsStale = true;
+}
+
+void Tokenization::Tokenizer::_buildAutomaton() {
+    this->_automatonIsStale = false;
+    this->_automaton = nullptr;
+    this->_rules.clear();
+    auto ruleRegexes = std::vector<std::string>{};
+    for (int i = 0; i < (int) this->_regexes.size(); i++) {
+        if (!Text::RegexAutomaton::supports(this->_regexes.at(i))) {
+            return;
+        }
+        if (this->_spellings.at(i).empty()) {
+            this->_rules.push_back({this->_kinds.at(i), -1});
+            ruleRegexes.push_back(this->_regexes.at(i));
         } else {
-            // We have not reached the end of the text. Thus, we should check 
-            // if the beginning of the text matches with some token pattern.
-            auto token = this->recognizeToken(text.substr(pos));
-            // Adjust the token position to the absolute position in relation 
-            // to the whole text.
-            token.startPos = pos;
-            token.endPos = pos + token.value.size();
-            token.startLocation = Text::Location{token.startPos, text.begin()};
-            token.endLocation = Text::Location{token.endPos, text.begin()};
-            // Add the token to the result only if it is not a comment 
-            // or whitespace, since we do not care about these.
-            if (token.type != "comment" && token.type != "whitespace") {
-                tokens.insert(tokens.end(), token);
+            for (auto& spelling : this->_spellings.at(i)) {
+                this->_rules.push_back({this->_kinds.at(i), Symbols::id(spelling)});
+                ruleRegexes.push_back(literalRegex(spelling));
             }
-            // Advance to the end of the found token.
-            pos = token.endPos;
         }
     }
-    return tokens;
+    this->_automaton = std::make_shared<Text::RegexAutomaton>(ruleRegexes);
 }
 
-void Tokenization::Tokenizer::addRegexPattern(TToken type, std::string regex) {
-    this->_patterns.insert(
-        this->_patterns.end(), 
-        std::shared_ptr<TokenPattern>(
-            new TokenPattern(
-                type, 
-                std::shared_ptr<ITextPattern>(new RegexPattern{regex})
-            )
-        )
-    );
-}
\ No newline at end of file
+void Tokenization::Tokenizer::_buildPatterns() {
+    this->_patterns.clear();
+    for (int i = 0; i < (int) this->_regexes.size(); i++) {
+        this->_patterns.push_back(std::make_shared<TokenPattern>(
+            Symbols::name(this->_kinds.at(i)), 
+            std::shared_ptr<ITextPattern>(new RegexPattern{this->_regexes.at(i)})
+        ));
+    }
+}
+
+void Tokenization::Tokenizer::_addCompiledRules(std::vector<TokenRule> rules, Text::DAutomaton automaton) {
+    // The compiled automaton only covers these rules, so earlier patterns need a new one.
+    bool usesCompiled = this->_regexes.empty();
+    auto spelling = std::string{};
+    for (auto& rule : rules) {
+        this->_kinds.push_back(Symbols::id(rule.kind));
+        this->_regexes.push_back(std::string{rule.regex});
+        if (literalSpelling(rule.regex, spelling)) {
+            this->_spellings.push_back({spelling});
+            this->_rules.push_back({this->_kinds.back(), Symbols::id(spelling)});
+        } else {
+            this->_spellings.push_back({});
+            this->_rules.push_back({this->_kinds.back(), -1});
+        }
+    }
+    if (usesCompiled) {
+        this->_automaton = std::make_shared<Text::RegexAutomaton>(automaton);
+        this->_automatonIsStale = false;
+    } else {
+        this->_automatonIsStale = true;
+    }
+}
@@ -3,8 +3,13 @@
 #include <memory>
 #include <utility>
 #include "DToken.h"
+#include "Symbols.h"
+#include "KeywordTable.h"
+#include "TokenSpecification.h"
+#include "../text/Source.h"
 #include "../text/ITextPattern.h"
 #include "../text/RegexPattern.h"
+#include "../text/RegexAutomaton.h"
 
 #ifndef TOKENIZATION_HH
 #define TOKENIZATION_HH
@@ -12,14 +17,121 @@
 namespace Tokenization {
     using TToken = std::string;
     using TokenPattern = std::pair<TToken, std::shared_ptr<ITextPattern>>;
+    /**
+     * Tokens together with the source they refer into. The source is 
+     * kept alive for as long as any copy of the tokenized text exists.
+     */
+    struct DTokenizedText {
+        std::shared_ptr<const Text::Source> source;
+        std::vector<DToken> tokens;
+    };
+    /**
+     * Splits text into tokens using the longest match among the added 
+     * patterns. When several patterns match equally far, the one added 
+     * first wins. Regex patterns are compiled into a single table-driven 
+     * automaton, so recognizing a token does not depend on the amount of patterns.
+     *
+     * Patterns that only match a few fixed strings, like keywords and operators, 
+     * have those strings interned as symbols so that their tokens carry the 
+     * symbol of their value.
+     *
+     * Keywords are not patterns of their own. Instead, tokens of the pattern the 
+     * keywords are added to, usually identifiers, are looked up from a keyword table 
+     * and take the kind of the keyword they spell.
+     */
     class Tokenizer {
         public:
             Tokenizer();
-            DToken recognizeToken(std::string text);
-            std::vector<DToken> tokenize(std::string text);
+            /**
+             * Recognizes the token starting at the given position in the source.
+             */
+            DToken recognizeToken(const Text::Source& source, int position);
+            /**
+             * Tokenizes the source. The returned tokens refer into the 
+             * source, so it has to outlive them.
+             */
+            std::vector<DToken> tokenize(const Text::Source& source);
+            /**
+             * Tokenizes the text into a source of its own, which is 
+             * returned along with the tokens referring into it.
+             */
+            DTokenizedText tokenize(std::string text);
             void addRegexPattern(TToken type, std::string regex);
+            /**
+             * Adds the rules of a token specification as patterns. Their automaton 
+             * was built while compiling, so nothing has to be compiled at runtime 
+             * unless patterns were added before them.
+             */
+            template<const auto& Rules>
+            void addSpecification() {
+                this->_addCompiledRules(
+                    std::vector<TokenRule>(Rules.begin(), Rules.end()), 
+                    TokenSpecification<Rules>::automaton.automaton()
+                );
+            }
+            /**
+             * Gives the tokens of the given type that spell a keyword the kind of that keyword.
+             */
+            template<std::size_t N>
+            void addKeywords(TToken type, const KeywordTable<N>& keywords) {
+                this->_keywordType = Symbols::id(type);
+                this->_keywordSeed = keywords.seed();
+                this->_keywordSlots.clear();
+                for (std::size_t i = 0; i < KeywordTable<N>::slotCount; i++) {
+                    this->_keywordSlots.push_back(keywords.slot(i));
+                }
+                this->_keywordSpellings.clear();
+                this->_keywordRules.clear();
+                for (std::size_t i = 0; i < N; i++) {
+                    this->_keywordSpellings.push_back(std::string{keywords.at(i).spelling});
+                    this->_keywordRules.push_back({
+                        Symbols::id(keywords.at(i).kind), 
+                        Symbols::id(keywords.at(i).spelling)
+                    });
+                }
+            }
         private:
+            /**
+             * The patterns as std::regex objects. Only needed when the automaton 
+             * does not support some pattern, so built lazily.
+             */
             std::vector<std::shared_ptr<TokenPattern>> _patterns;
+            std::vector<int> _kinds;
+            std::vector<std::string> _regexes;
+            /**
+             * The fixed strings matched by each pattern, or an empty list 
+             * if the pattern matches too many strings to list them.
+             */
+            std::vector<std::vector<std::string>> _spellings;
+            /**
+             * The kind and value symbol reported by each rule of the automaton. Each 
+             * spelling of a pattern becomes a rule of its own, so the automaton 
+             * directly tells which symbol was matched.
+             */
+            std::vector<std::pair<int, int>> _rules;
+            /**
+             * A copy of the keyword table: its seed, its slots, and the spelling, 
+             * kind and value symbol of each keyword.
+             */
+            int _keywordType;
+            std::uint32_t _keywordSeed;
+            std::vector<int> _keywordSlots;
+            std::vector<std::string> _keywordSpellings;
+            std::vector<std::pair<int, int>> _keywordRules;
+            /**
+             * The automaton recognizing all patterns. Built lazily when tokenizing 
+             * and left empty if some pattern uses syntax the automaton does not support.
+             */
+            std::shared_ptr<Text::RegexAutomaton> _automaton;
+            bool _automatonIsStale;
+            void _buildAutomaton();
+            void _buildPatterns();
+            void _addCompiledRules(std::vector<TokenRule> rules, Text::DAutomaton automaton);
+            /**
+             * Returns the kind and value symbol of the keyword the word spells, 
+             * or the given ones if it is not a keyword.
+             */
+            std::pair<int, int> _keywordRule(std::pair<int, int> rule, std::string_view word);
     };
 }
 
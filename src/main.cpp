@@ -2,6 +2,7 @@
 #include <fstream>
 #include <cassert>
 #include <array>
+#include <thread>
 #include "my-language/tokenizer/Tokenizer.h"
 #include "my-language/parser/Parser.h"
 #include "my-language/ir-generator/ModuleIRGenerator.h"
@@ -15,30 +16,24 @@ int main(int argc, char* argv[]) {
     auto tokenizer = Tokenizer{};
     auto parser = MyLanguage::Parser{};
     auto typeChecker = MyLanguage::TypeChecker{};
+    typeChecker.setThreads(std::thread::hardware_concurrency());
     auto irGenerator = MyLanguage::ModuleIRGenerator{};
     auto assemblyGenerator = MyLanguage::X86AssemblyGenerator{};
 
-    // Read input code file.
-    auto codeFile = std::ifstream{argv[1]};
-    auto code = std::string{};
-    if (codeFile.is_open()) {
-        while (codeFile.good()) {
-            code.push_back(codeFile.get());
-        }
-    } else {
-        throw std::runtime_error("Could not open input code file.");
-    }
-
-    if (code.size() < 2) {
+    // Map the input code file into memory.
+    auto source = Text::Source::map(argv[1]);
+    if (source->size() == 0) {
         std::cout << "The input code file cannot be empty." << std::endl;
-    } else {
-        // Remove the end of file character.
-        code.pop_back();
     }
 
-    // Compile the code into assembly.
-    auto tokens = tokenizer.tokenizer.tokenize(code);
-    auto root = parser.parse(tokens, 0);
+    // Compile the code into assembly. Tokens are pulled from the source 
+    // as the parser needs them, and the expressions of the syntax tree and 
+    // the IR are all released with the arena.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+    auto tokenStream = Tokenization::TokenStream{tokenizer.tokenizer, *source};
+    auto tokens = TokenSequence{tokenStream};
+    auto root = parser.parse(tokens);
     typeChecker.check(root);
     auto irCommands = irGenerator.generate(root);
     auto assemblyCode = assemblyGenerator.generate(irCommands);
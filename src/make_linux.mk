@@ -27,43 +27,67 @@ OBJS =  \
 	my-language/parser/ModuleParser.o \
 	my-language/parser/ExpressionFactory.o \
 	my-language/parser/TypeParser.o \
+	my-language/parser/NodeKinds.o \
 	my-language/ir-generator/IRGenerator.o \
 	my-language/ir-generator/ModuleIRGenerator.o \
 	my-language/ir-generator/TIRCommand.o \
 	my-language/ir-generator/IRCommandFactory.o \
 	my-language/assembly-generator/AssemblyGenerator.o \
 	my-language/assembly-generator/X86AssemblyGenerator.o \
-	my-language/type-checker/Type.o \
-	my-language/type-checker/FunctionType.o \
+	my-language/type-checker/TypeTable.o \
 	my-language/type-checker/TypeChecker.o \
 	components/tokenization/Tokenization.o \
+	components/tokenization/Symbols.o \
+	components/tokenization/TokenStream.o \
 	components/text/RegexPattern.o \
 	components/text/Location.o \
+	components/text/Source.o \
+	components/text/RegexAutomaton.o \
+	components/text/ByteScanner.o \
 	components/parsing/OperatedChainParser.o \
+	components/parsing/ParseResult.o \
+	components/parsing/ParseSession.o \
+	components/parsing/GrammarAnalysis.o \
 	components/parsing/TokenSequence.o \
 	components/parsing/MapParser.o \
 	components/parsing/UnaryParser.o \
 	components/parsing/BinaryParser.o \
 	components/parsing/LiteralParser.o \
 	components/parsing/Expression.o \
+	components/parsing/ExpressionArena.o \
+	components/parsing/Names.o \
 	components/parsing/ParentheticalParser.o \
 	components/parsing/ChainParser.o \
 	components/parsing/SkeletonParser.o \
 	components/parsing/ConflictParser.o \
 	components/parsing/ListParser.o \
 	components/structured-language/VariableStack.o \
+	components/concurrency/ThreadPool.o \
 
 TEST_OBJS = \
 	my-language/tokenizer/test/Tokenizer.test.o \
 	my-language/parser/test/Parser.test.o \
 	my-language/ir-generator/test/IRGenerator.test.o \
 	my-language/assembly-generator/test/X86AssemblyGenerator.test.o \
+	my-language/type-checker/test/TypeChecker.test.o \
 	components/parsing/test/OperatedChainParser.test.o \
+	components/data_structures/test/TreeFold.test.o \
+	components/data_structures/test/ScopedSymbolTable.test.o \
 	test/manual.o \
 
 TEST_OBJ = \
 	my-language/assembly-generator/test/X86AssemblyGenerator.test.o
 
+# Benchmark executables. Build with e.g. OPTIMIZATION=-O2 for meaningful numbers.
+BENCHMARK_TARGETS = \
+	my-language/tokenizer/benchmark/Tokenizer.benchmark.out \
+	my-language/parser/benchmark/Parser.benchmark.out \
+	my-language/parser/benchmark/Complexity.benchmark.out \
+	my-language/benchmark/Passes.benchmark.out \
+
+# Extra compiler flags, such as an optimization level.
+OPTIMIZATION =
+
 # Here is a Make Macro defined by two Macro Expansions.
 # A Macro Expansion may be treated as a textual replacement of the Make Macro.
 # Macro Expansions are introduced with $ and enclosed in (parentheses).
@@ -75,7 +99,7 @@ REBUILDABLES = $(MAIN_OBJ) $(OBJS) $(LINK_TARGET)
 # and two Commands (indented by tabs on the lines that follow).
 # The space before the colon is not required but added here for clarity.
 clean : 
-	rm $(OBJS) $(TEST_OBJS) $(MAIN_OBJ)
+	rm $(OBJS) $(TEST_OBJS) $(MAIN_OBJ) $(BENCHMARK_TARGETS)
 	echo Clean done
 
 # There are two standard Targets your Makefile should probably have:
@@ -92,6 +116,28 @@ all : $(LINK_TARGET)
 test : $(TEST_TARGET)
 	echo Tests done
 
+benchmark : $(BENCHMARK_TARGETS)
+	echo Benchmarks built
+
+# Runs the tokenizer benchmark, which prints its results as JSON. 
+# Use e.g. make -f make_linux.mk tokenizer-benchmark OPTIMIZATION=-O2 BENCHMARK_MEGABYTES=10
+BENCHMARK_MEGABYTES = 100
+tokenizer-benchmark : my-language/tokenizer/benchmark/Tokenizer.benchmark.out
+	./my-language/tokenizer/benchmark/Tokenizer.benchmark.out $(BENCHMARK_MEGABYTES)
+
+# Fails when parsing time grows faster than n log n in any family of inputs.
+# Use e.g. make -f make_linux.mk parser-complexity OPTIMIZATION=-O2 COMPLEXITY_DOUBLINGS=8
+COMPLEXITY_DOUBLINGS = 6
+parser-complexity : my-language/parser/benchmark/Complexity.benchmark.out
+	./my-language/parser/benchmark/Complexity.benchmark.out $(COMPLEXITY_DOUBLINGS)
+
+# Times each phase of the compiler on a large module.
+# Use e.g. make -f make_linux.mk passes-benchmark OPTIMIZATION=-O2 PASSES_MEGABYTES=4 PASSES_THREADS=4
+PASSES_MEGABYTES = 1
+PASSES_THREADS = 1
+passes-benchmark : my-language/benchmark/Passes.benchmark.out
+	./my-language/benchmark/Passes.benchmark.out $(PASSES_MEGABYTES) 5 $(PASSES_THREADS)
+
 # There is no required order to the list of rules as they appear in the Makefile.
 # Make will build its own dependency tree and only execute each rule only once
 # its dependencies' rules have been executed successfully.
@@ -100,11 +146,15 @@ test : $(TEST_TARGET)
 # $@ expands to the rule's target, in this case "test_me.exe".
 # $^ expands to the rule's dependencies.
 $(LINK_TARGET) : $(MAIN_OBJ) $(OBJS)
-	g++-13 -ansi -pedantic-errors -g -o $@ $^
+	g++-13 -ansi -pedantic-errors -g -pthread -o $@ $^
 
 # Compiles the test target.
 $(TEST_TARGET) : $(OBJS) $(TEST_OBJ)
-	g++-13 -ansi -pedantic-errors -g -o $@ $^
+	g++-13 -ansi -pedantic-errors -g -pthread -o $@ $^
+
+# Links each benchmark with the objects it measures.
+%.benchmark.out : %.benchmark.o $(OBJS)
+	g++-13 -ansi -pedantic-errors -g -pthread -o $@ $^
 
 # Here is a Pattern Rule, often used for compile-line.
 # It says how to create a file with a .o suffix, given a file with a .cpp suffix.
@@ -112,7 +162,7 @@ $(TEST_TARGET) : $(OBJS) $(TEST_OBJ)
 # $@ for the pattern-matched target
 # $< for the pattern-matched dependency
 %.o : %.cpp
-	g++-13 -ansi -pedantic-errors -std=c++20 -g -o $@ -c $<
+	g++-13 -ansi -pedantic-errors -std=c++20 -g -pthread $(OPTIMIZATION) -o $@ -c $<
 
 # These are Dependency Rules, which are rules without any command.
 # Dependency Rules indicate that if any file to the right of the colon changes,
@@ -2,7 +2,8 @@
 #include <iostream>
 
 namespace MyLanguage {
-    AssemblyGenerator::AssemblyGenerator()
+    AssemblyGenerator::AssemblyGenerator():
+        _commandKey(Expression::registerAttribute("command", Expression::EAttributeSlot::name))
     {
         
     }
@@ -29,33 +30,32 @@ namespace MyLanguage {
         variableStack.push(variableNamesList);
 
         // Generate assembly code for each IR command and join it all together.
-        return std::accumulate(
-            irCommands.begin(), 
-            irCommands.end(), 
-            std::string(""), 
-            [this, &variableStack](std::string assembly, TIRCommand command) {
-                auto commandType = command->subTypes().at("command");
-                if (this->_generators.contains(commandType)) {
-                    assembly = assembly + this->_indent + "# " + commandType + "\n";
-                    auto generator = this->_generators.at(commandType);
-                    return assembly + generator(variableStack, this->_indent, command);
-                } else {
-                    throw std::runtime_error("No assembly generator found for command with type: '" + commandType + "'.");
-                }
+        auto assembly = std::string{};
+        for (auto command : irCommands) {
+            auto commandId = command->attributeId(this->_commandKey);
+            auto generator = (
+                commandId >= 0 && commandId < (int) this->_generators.size() ? 
+                this->_generators[commandId] : 
+                nullptr
+            );
+            if (generator == nullptr) {
+                throw std::runtime_error(
+                    "No assembly generator found for command with type: '" + command->subTypes().at("command") + "'."
+                );
             }
-        );
+            assembly += this->_indent + "# " + Parsing::Names::name(commandId) + "\n";
+            assembly += generator(variableStack, this->_indent, command);
+        }
+        return assembly;
     }
 
     std::string AssemblyGenerator::generate(std::map<std::string, std::vector<TIRCommand>> irCommands)
     {
-        return this->_prelude + std::accumulate(
-            irCommands.begin(), 
-            irCommands.end(), 
-            std::string(""), 
-            [this](std::string assembly, std::pair<std::string, std::vector<TIRCommand>> p) {
-                return assembly + this->generateForFunction(p.second);
-            }
-        );
+        auto assembly = this->_prelude;
+        for (auto& function : irCommands) {
+            assembly += this->generateForFunction(function.second);
+        }
+        return assembly;
     }
 
     std::string AssemblyGenerator::prelude()
@@ -68,9 +68,13 @@ namespace MyLanguage {
         return this->_indent;
     }
 
-    std::map<std::string, AssemblyGenerator::TGenerator>& AssemblyGenerator::generators()
+    void AssemblyGenerator::setGenerator(const std::string& commandType, TGenerator generator)
     {
-        return this->_generators;
+        auto commandId = Parsing::Names::id(commandType);
+        if (commandId >= (int) this->_generators.size()) {
+            this->_generators.resize(commandId + 1, nullptr);
+        }
+        this->_generators[commandId] = generator;
     }
     
     void AssemblyGenerator::setPrelude(std::string prelude)
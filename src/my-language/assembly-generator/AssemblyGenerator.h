@@ -17,15 +17,15 @@ namespace MyLanguage {
      */
     class AssemblyGenerator {
         public:
-            using TExpression = std::shared_ptr<Expression>;
+            using TExpression = Expression*;
             /**
              * Type of a function that generates assembly code from a given IR command.
              */
-            using TGenerator = std::function<std::string(
+            using TGenerator = std::string (*)(
                 StructuredLanguage::VariableStack&,
                 std::string indent,
                 TIRCommand
-            )>;
+            );
             AssemblyGenerator();
 
             /**
@@ -39,14 +39,22 @@ namespace MyLanguage {
             std::string generate(std::map<std::string, std::vector<TIRCommand>> irCommands);
             std::string prelude();
             std::string indent();
-            std::map<std::string, TGenerator>& generators();
+            /**
+             * Sets the assembly generator function for the IR commands of the given type.
+             */
+            void setGenerator(const std::string& commandType, TGenerator generator);
             void setPrelude(std::string prelude);
             void setIndent(std::string indent);
         private:
             /**
-             * Contains the assembly generator functions for each type of IRCommand.
+             * Contains the assembly generator functions for each type of IRCommand, indexed 
+             * by the interned id of the type, or nullptr for types without one.
+             */
+            std::vector<TGenerator> _generators;
+            /**
+             * The key of the attribute telling the type of IR commands.
              */
-            std::map<std::string, TGenerator> _generators;
+            int _commandKey;
             /**
              * The assembly declarations and code that precedes the generated program's assembly code.
              */
@@ -328,17 +328,17 @@ namespace MyLanguage {
         );
 
         // Configure assembly generating functions for each IR command type.
-        this->_assemblyGenerator.generators().insert({"LoadIntConst", X86AssemblyGenerators::generateLoadIntConst});
-        this->_assemblyGenerator.generators().insert({"LoadBoolConst", X86AssemblyGenerators::generateLoadBoolConst});
-        this->_assemblyGenerator.generators().insert({"CondJump", X86AssemblyGenerators::generateCondJump});
-        this->_assemblyGenerator.generators().insert({"Jump", X86AssemblyGenerators::generateJump});
-        this->_assemblyGenerator.generators().insert({"Label", X86AssemblyGenerators::generateLabel});
-        this->_assemblyGenerator.generators().insert({"FunctionLabel", X86AssemblyGenerators::generateFunctionLabel});
-        this->_assemblyGenerator.generators().insert({"Call", X86AssemblyGenerators::generateCall});
-        this->_assemblyGenerator.generators().insert({"Copy", X86AssemblyGenerators::generateCopy});
-        this->_assemblyGenerator.generators().insert({"CopyToAddressOf", X86AssemblyGenerators::generateCopyToAddressOf});
-        this->_assemblyGenerator.generators().insert({"WriteFunctionReturn", X86AssemblyGenerators::generateWriteFunctionReturn});
-        this->_assemblyGenerator.generators().insert({"LoadFunctionParam", X86AssemblyGenerators::generateLoadFunctionParam});
+        this->_assemblyGenerator.setGenerator("LoadIntConst", X86AssemblyGenerators::generateLoadIntConst);
+        this->_assemblyGenerator.setGenerator("LoadBoolConst", X86AssemblyGenerators::generateLoadBoolConst);
+        this->_assemblyGenerator.setGenerator("CondJump", X86AssemblyGenerators::generateCondJump);
+        this->_assemblyGenerator.setGenerator("Jump", X86AssemblyGenerators::generateJump);
+        this->_assemblyGenerator.setGenerator("Label", X86AssemblyGenerators::generateLabel);
+        this->_assemblyGenerator.setGenerator("FunctionLabel", X86AssemblyGenerators::generateFunctionLabel);
+        this->_assemblyGenerator.setGenerator("Call", X86AssemblyGenerators::generateCall);
+        this->_assemblyGenerator.setGenerator("Copy", X86AssemblyGenerators::generateCopy);
+        this->_assemblyGenerator.setGenerator("CopyToAddressOf", X86AssemblyGenerators::generateCopyToAddressOf);
+        this->_assemblyGenerator.setGenerator("WriteFunctionReturn", X86AssemblyGenerators::generateWriteFunctionReturn);
+        this->_assemblyGenerator.setGenerator("LoadFunctionParam", X86AssemblyGenerators::generateLoadFunctionParam);
     }
 
     std::string X86AssemblyGenerator::generate(std::map<std::string, std::vector<TIRCommand>> irCommands)
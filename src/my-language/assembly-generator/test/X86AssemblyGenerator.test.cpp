@@ -9,6 +9,9 @@
 #include <iostream>
 
 namespace Test {
+    // The expressions of all tests live as long as the test program.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
     auto parser = MyLanguage::Parser{};
     auto tokenizer = Tokenizer{};
     auto irGenerator = MyLanguage::ModuleIRGenerator{};
@@ -18,7 +21,8 @@ namespace Test {
 
 TEST_CASE("generate") {
     auto input = "while true do 1;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
     auto root = Test::parser.parse(tokens, 0);
     Test::typeChecker.check(root);
     auto irCommands = Test::irGenerator.generate(root);
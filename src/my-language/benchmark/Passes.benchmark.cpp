@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../tokenizer/Tokenizer.h"
+#include "../parser/Parser.h"
+#include "../type-checker/TypeChecker.h"
+#include "../ir-generator/ModuleIRGenerator.h"
+#include "../assembly-generator/X86AssemblyGenerator.h"
+
+/**
+ * Measures the time each phase of the compiler takes on a large module of function
+ * definitions: tokenizing, parsing, type checking, generating the IR and generating
+ * the assembly. Each phase is run several times on the same input and the fastest
+ * run is reported, along with the amount of syntax tree expressions or IR commands
+ * the phase went through per second. Type checking runs on the given amount of threads.
+ *
+ * Usage: Passes.benchmark.out [size in megabytes] [rounds] [threads]
+ */
+
+// A function definition that is repeated to form the input. The name of the
+// function is made unique for each repetition.
+const std::string snippetStart = "fun fibonacci";
+const std::string snippetEnd =
+    "(n: Int): Int {\n"
+    "    var previous: Int = 0;\n"
+    "    var current: Int = 1;\n"
+    "    var pointer: Int* = &current;\n"
+    "    while n > 0 do {\n"
+    "        var next: Int = previous + *pointer * 1;\n"
+    "        previous = current;\n"
+    "        current = next;\n"
+    "        if current > 1000 then { break; };\n"
+    "        n = n - 1;\n"
+    "    };\n"
+    "    return if not (previous == 0) or false then previous else -(1 % 7);\n"
+    "}\n";
+
+std::string createInput(size_t size) {
+    std::string input;
+    input.reserve(size + snippetStart.size() + snippetEnd.size() + 16);
+    for (int i = 0; input.size() < size; i++) {
+        input += snippetStart + std::to_string(i) + snippetEnd;
+    }
+    return input + "print_int(fibonacci0(10));\n";
+}
+
+// Runs the phase the given amount of times and returns the time of the fastest run.
+double fastestSeconds(int rounds, std::function<void()> phase) {
+    double fastest = 0;
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        phase();
+        auto end = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        fastest = round == 0 ? seconds : std::min(fastest, seconds);
+    }
+    return fastest;
+}
+
+void report(std::string phase, double seconds, size_t items) {
+    std::cout << phase << "\t" << seconds << "\t" << items << "\t" << items / seconds << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    double megabytes = argc > 1 ? std::atof(argv[1]) : 1;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    int threads = argc > 3 ? std::atoi(argv[3]) : 1;
+    auto tokenizer = Tokenizer{};
+    auto parser = MyLanguage::Parser{};
+    auto typeChecker = MyLanguage::TypeChecker{};
+    typeChecker.setThreads(threads);
+    auto irGenerator = MyLanguage::ModuleIRGenerator{};
+    auto assemblyGenerator = MyLanguage::X86AssemblyGenerator{};
+
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+    auto input = Text::Source{createInput((size_t) (megabytes * 1024 * 1024))};
+    auto tokens = tokenizer.tokenizer.tokenize(input);
+    auto root = parser.parse(tokens, 0);
+    int expressions = Expression::size(root);
+    auto irCommands = irGenerator.generate(root);
+    size_t commands = 0;
+    for (auto& function : irCommands) {
+        commands = commands + function.second.size();
+    }
+
+    std::cout << "megabytes\t" << input.text().size() / (1024.0 * 1024.0) << std::endl;
+    std::cout << std::endl << "phase\tseconds\titems\titems/s" << std::endl;
+    report("tokenize", fastestSeconds(rounds, [&]() {
+        tokenizer.tokenizer.tokenize(input);
+    }), tokens.size());
+    report("parse", fastestSeconds(rounds, [&]() {
+        auto parseArena = Parsing::ExpressionArena{};
+        auto parseArenaScope = Parsing::ExpressionArena::Scope{parseArena};
+        parser.parse(tokens, 0);
+    }), expressions);
+    report("type check", fastestSeconds(rounds, [&]() {
+        typeChecker.check(root);
+    }), expressions);
+    report("generate IR", fastestSeconds(rounds, [&]() {
+        auto irArena = Parsing::ExpressionArena{};
+        auto irArenaScope = Parsing::ExpressionArena::Scope{irArena};
+        irGenerator.generate(root);
+    }), expressions);
+    report("generate assembly", fastestSeconds(rounds, [&]() {
+        assemblyGenerator.generate(irCommands);
+    }), commands);
+    return 0;
+}
@@ -3,22 +3,27 @@
 namespace MyLanguage {
     IRCommandFactory::IRCommandFactory()
     {
+        // The attributes of IR commands besides the names of their variables, functions and labels.
+        Expression::registerAttribute("command", Expression::EAttributeSlot::name);
+        Expression::registerAttribute("value", Expression::EAttributeSlot::value);
+        Expression::registerAttribute("index", Expression::EAttributeSlot::value);
     }
 
-    std::shared_ptr<Expression> IRCommandFactory::createExpression(std::string type, std::string attribute, std::string value)
+    Expression* IRCommandFactory::createExpression(std::string type, std::string attribute, std::string value)
     {
-        auto expression = std::shared_ptr<Expression>{new Expression{type, -1, -1}};
+        auto expression = Expression::create(type, -1, -1);
         expression->subTypes().insert({attribute, value});
         return expression;
     }
 
     TIRCommand IRCommandFactory::createVariableList(std::vector<std::string> variables)
     {
-        auto root = std::shared_ptr<Expression>{new Expression{"variable-list", -1, -1}};
-        std::for_each(variables.begin(), variables.end(), [root, this](std::string variable) {
-            auto child = this->createExpression("variable", "name", variable);
-            root->children().insert(root->children().end(), child);
+        auto root = Expression::create("variable-list", -1, -1);
+        auto children = std::vector<Expression*>{};
+        std::for_each(variables.begin(), variables.end(), [&children, this](std::string variable) {
+            children.push_back(this->createExpression("variable", "name", variable));
         });
+        root->setChildren(children);
         return root;
     }
     
@@ -10,8 +10,8 @@ namespace MyLanguage {
     class IRCommandFactory {
         public:
             IRCommandFactory();
-            std::shared_ptr<Expression> createExpression(std::string type, std::string attribute, std::string value);
-            std::shared_ptr<Expression> createVariableList(std::vector<std::string> variables);
+            Expression* createExpression(std::string type, std::string attribute, std::string value);
+            Expression* createVariableList(std::vector<std::string> variables);
             TIRCommand createLoadIntConst(std::string value, std::string variable);
             TIRCommand createLoadBoolConst(std::string value, std::string variable);
             TIRCommand createLoadFunctionParam(int index, std::string variable);
@@ -15,7 +15,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* nullGenerator(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             return context;
         }
@@ -25,9 +25,9 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateNumber(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto number = expression->rootToken().value;
+            auto number = std::string{expression->rootToken().value()};
             auto variable = context->commandFactory->nextVariable();
             auto command = context->commandFactory->createLoadIntConst(number, variable);
             context->variableStack.push({variable});
@@ -40,9 +40,9 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateBoolean(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto booleanValue = expression->rootToken().value;
+            auto booleanValue = std::string{expression->rootToken().value()};
             auto variable = context->commandFactory->nextVariable();
             auto command = context->commandFactory->createLoadBoolConst(booleanValue, variable);
             context->variableStack.push({variable});
@@ -55,17 +55,16 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateVariableDeclaration(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             assert(expression->subTypes().contains("name"));
-            auto variableName = expression->subTypes().at("name");
             // The value on the right side of the variable is given by the IR variable
             // at the top of the variable stack.
             auto rightVariable = (context->variableStack.pop(1)).at(0);
             // Create the IR variable for the newly created variable.
             auto irVariable = context->commandFactory->nextVariable();
             // Insert the newly created variable to the symbol table and the variable stack.
-            context->symbolTable.insert(variableName, irVariable);
+            context->symbolTable.insert(expression->nameId(), irVariable);
             context->variableStack.push({irVariable});
             // Assign the value on the right side to the newly created variable.
             auto command = context->commandFactory->createCopy(rightVariable, irVariable);
@@ -78,12 +77,12 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateIdentifier(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto name = expression->subTypes().at("name");
             // If the variable name is a recognized variable that has been declared previously.
-            if (context->symbolTable.contains(name)) {
-                auto irVariable = context->symbolTable.at(name);
+            if (context->symbolTable.contains(expression->nameId())) {
+                auto irVariable = context->symbolTable.at(expression->nameId());
                 context->variableStack.push({irVariable});
             } else {
                 // Else, the variable name is the name of a function, in which case we use 
@@ -99,7 +98,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateBlock(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Leave the block's local variable scope.
             context->symbolTable.popFront();
@@ -111,7 +110,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateReturn(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // If the return statement returns a proper value instead of returning nothing.
             if (expression->children().size() > 0) {
@@ -136,7 +135,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateBreak(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto endLabel = context->loopLabelStack.stack().top();
             // Generate jump command that jumps past the loop.
@@ -160,7 +159,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateContinue(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto continueLabel = context->loopLabelStack.top(2).at(0);
             // Generate jump command that jumps to the condition portion of the loop.
@@ -174,7 +173,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateChain(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             if (expression->children().size() > 0) {
                 auto irVariables = context->variableStack.pop(expression->children().size());
@@ -194,7 +193,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateFunctionCall(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             assert(expression->subTypes().contains("name"));
             // Gather the variable names storing the argument values.
@@ -213,9 +212,9 @@ namespace MyLanguage {
                 context->variableStack.stack().push(argumentVars.at(0));
             } else {
                 functionName = (
-                    !(context->symbolTable.contains(functionName)) ?
+                    !(context->symbolTable.contains(expression->nameId())) ?
                         functionName :
-                        context->symbolTable.at(functionName)
+                        context->symbolTable.at(expression->nameId())
                 );
                 if (functionName == "new") {
                     functionName = "malloc";
@@ -242,7 +241,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateAssignment(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             assert(expression->children().size() == 2);
             auto leftHand = expression->children().at(0);
@@ -250,7 +249,7 @@ namespace MyLanguage {
             auto rightIRVariable = irVariables.at(1);
             auto leftIRVariable = irVariables.at(0);
             
-            std::shared_ptr<Expression> command;
+            Expression* command;
 
             // If the left hand expression is a variable name.
             if (leftHand->type() == "identifier") {
@@ -262,8 +261,7 @@ namespace MyLanguage {
                 // If there is only one level of dereference operators.
                 if (leftHand->children().at(0)->type() == "identifier") {
                     // Then we want to find the IR variable of the left hand variable being dereferenced.
-                    auto variableName = leftHand->children().at(0)->subTypes().at("name");
-                    leftIRVariable = context->symbolTable.at(variableName);
+                    leftIRVariable = context->symbolTable.at(leftHand->children().at(0)->nameId());
                 } else {
                     // There is more than one level of dereference operators.
                     // Then, we want the IR variable that was generated 
@@ -288,7 +286,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* inGenerateBoolean(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             int childIndex,
             std::string operation
         ) {
@@ -360,7 +358,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateBinaryOperator(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             if (expression->subTypes().at("name") == "=") {
                 return generateAssignment(context, expression);
@@ -376,7 +374,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateIf(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Get the label ending the entire if-block.
             auto endLabel = context->labelStack.pop();
@@ -391,7 +389,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateWhile(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Return the result of the loop.
             auto resultVar = context->loopVariableStack.pop();
@@ -405,7 +403,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* inGenerateIf(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             int childIndex
         ) {
             // If we have just generated the IR commands for the condition expression.
@@ -461,7 +459,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* preGenerateWhile(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Create the IR label beginning the condition portion of the while-do block.
             auto conditionLabel = context->commandFactory->nextLabel();
@@ -484,7 +482,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* preGenerateFunction(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Generate the label beginning the function.
             auto label = context->commandFactory->createFunctionLabel(expression->subTypes().at("name"));
@@ -497,7 +495,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateFunctionDefinition(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Check if there is a return statement within the definition.
             auto returns = std::count_if(expression->children().begin(), expression->children().end(), [](auto child) {
@@ -520,14 +518,13 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* inGenerateFunctionParameterList(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             int childIndex
         ) {
             auto parameter = expression->children().at(childIndex);
-            auto parameterName = parameter->subTypes().at("name");
             auto irVariable = context->commandFactory->nextVariable();
             auto command = context->commandFactory->createLoadFunctionParam(childIndex, irVariable);
-            context->symbolTable.insert(parameterName, irVariable);
+            context->symbolTable.insert(parameter->nameId(), irVariable);
             context->irCommands.insert(context->irCommands.end(), command);
             return context;
         }
@@ -538,7 +535,7 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* inGenerateWhile(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             int childIndex
         ) {
             // If we have just generated the IR commands for the condition expression.
@@ -598,14 +595,30 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* generateAny(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            if (context->irGenerators->contains(expression->type())) {
-                // Choose the corresponding IR generator function.
-                auto generate = context->irGenerators->at(expression->type());
-                return generate(context, expression);
-            } else {
-                throw std::runtime_error("No IR generator found for type: '" + expression->type() + "'.");
+            // Choose the corresponding IR generator function.
+            switch (NodeKinds::of(expression)) {
+                case ENodeKind::number: return generateNumber(context, expression);
+                case ENodeKind::boolean: return generateBoolean(context, expression);
+                case ENodeKind::chain: return generateChain(context, expression);
+                case ENodeKind::binaryOperator: return generateBinaryOperator(context, expression);
+                case ENodeKind::unaryOperator: return generateFunctionCall(context, expression);
+                case ENodeKind::functionCall: return generateFunctionCall(context, expression);
+                case ENodeKind::variableDeclaration: return generateVariableDeclaration(context, expression);
+                case ENodeKind::identifier: return generateIdentifier(context, expression);
+                case ENodeKind::block: return generateBlock(context, expression);
+                case ENodeKind::parenthetical: return nullGenerator(context, expression);
+                case ENodeKind::ifExpression: return generateIf(context, expression);
+                case ENodeKind::whileExpression: return generateWhile(context, expression);
+                case ENodeKind::function: return nullGenerator(context, expression);
+                case ENodeKind::functionParameterList: return nullGenerator(context, expression);
+                case ENodeKind::functionParameter: return nullGenerator(context, expression);
+                case ENodeKind::functionDefinition: return generateFunctionDefinition(context, expression);
+                case ENodeKind::returnExpression: return generateReturn(context, expression);
+                case ENodeKind::breakExpression: return generateBreak(context, expression);
+                case ENodeKind::continueExpression: return generateContinue(context, expression);
+                default: throw std::runtime_error("No IR generator found for type: '" + expression->type() + "'.");
             }
         }
 
@@ -615,18 +628,16 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* preGenerateAny(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            // Create new local variable scope when encountering a block expression.
-            if (expression->type() == "block") {
-                context->symbolTable.pushFront();
-                return context;
-            } else if (expression->type() == "while") {
-                return preGenerateWhile(context, expression);
-            } else if (expression->type() == "function") {
-                return preGenerateFunction(context, expression);
-            } else {
-                return context;
+            switch (NodeKinds::of(expression)) {
+                // Create new local variable scope when encountering a block expression.
+                case ENodeKind::block: 
+                    context->symbolTable.pushFront();
+                    return context;
+                case ENodeKind::whileExpression: return preGenerateWhile(context, expression);
+                case ENodeKind::function: return preGenerateFunction(context, expression);
+                default: return context;
             }
         }
 
@@ -636,62 +647,36 @@ namespace MyLanguage {
          */
         IRGenerator::DGeneratorContext* inGenerateAny(
             IRGenerator::DGeneratorContext* context,
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             int childIndex
         ) {
-            // Create new local variable scope when encountering a block expression.
-            if (expression->type() == "if") {
-                return inGenerateIf(context, expression, childIndex);
-            } else if (expression->type() == "while") {
-                return inGenerateWhile(context, expression, childIndex);
-            } else if (
-                expression->type() == "binary-operator" && 
-                (expression->subTypes().at("name") == "and" || expression->subTypes().at("name") == "or")
-            ) {
-                return inGenerateBoolean(context, expression, childIndex, expression->subTypes().at("name"));
-            } else if (expression->type() == "function-parameter-list") {
-                return inGenerateFunctionParameterList(context, expression, childIndex);
-            } else {
-                return context;
+            switch (NodeKinds::of(expression)) {
+                case ENodeKind::ifExpression: return inGenerateIf(context, expression, childIndex);
+                case ENodeKind::whileExpression: return inGenerateWhile(context, expression, childIndex);
+                case ENodeKind::binaryOperator: {
+                    auto& operatorName = expression->subTypes().at("name");
+                    if (operatorName == "and" || operatorName == "or") {
+                        return inGenerateBoolean(context, expression, childIndex, operatorName);
+                    }
+                    return context;
+                }
+                case ENodeKind::functionParameterList: return inGenerateFunctionParameterList(context, expression, childIndex);
+                default: return context;
             }
         }
     }
 
     IRGenerator::IRGenerator()
     {
-        this->_irGenerators.insert({"number", IRGenerators::generateNumber});
-        this->_irGenerators.insert({"boolean", IRGenerators::generateBoolean});
-        this->_irGenerators.insert({"chain", IRGenerators::generateChain});
-        this->_irGenerators.insert({"binary-operator", IRGenerators::generateBinaryOperator});
-        this->_irGenerators.insert({"unary-operator", IRGenerators::generateFunctionCall});
-        this->_irGenerators.insert({"function-call", IRGenerators::generateFunctionCall});
-        this->_irGenerators.insert({"variable-declaration", IRGenerators::generateVariableDeclaration});
-        this->_irGenerators.insert({"identifier", IRGenerators::generateIdentifier});
-        this->_irGenerators.insert({"block", IRGenerators::generateBlock});
-        this->_irGenerators.insert({"parenthetical", IRGenerators::nullGenerator});
-        this->_irGenerators.insert({"if", IRGenerators::generateIf});
-        this->_irGenerators.insert({"while", IRGenerators::generateWhile});
-        this->_irGenerators.insert({"function", IRGenerators::nullGenerator});
-        this->_irGenerators.insert({"function-parameter-list", IRGenerators::nullGenerator});
-        this->_irGenerators.insert({"function-parameter", IRGenerators::nullGenerator});
-        this->_irGenerators.insert({"function-definition", IRGenerators::generateFunctionDefinition});
-        this->_irGenerators.insert({"return", IRGenerators::generateReturn});
-        this->_irGenerators.insert({"break", IRGenerators::generateBreak});
-        this->_irGenerators.insert({"continue", IRGenerators::generateContinue});
-    }
-
-    std::vector<TIRCommand> IRGenerator::generate(std::shared_ptr<Expression> root)
-    {
-        auto context = IRGenerator::DGeneratorContext{&this->_irGenerators, &this->_commandFactory};
-        auto foldable = DataStructures::FoldableNode<IRGenerator::DGeneratorContext*, IRGenerator::TExpression>{root};
-        foldable.setPreFolder(IRGenerators::preGenerateAny);
-        foldable.setInFolder(IRGenerators::inGenerateAny);
-
-        return foldable.fold(IRGenerators::generateAny, &context)->irCommands;
     }
 
-    std::map<std::string, IRGenerator::TIRGenerator>& IRGenerator::irGenerators()
+    std::vector<TIRCommand> IRGenerator::generate(Expression* root)
     {
-        return this->_irGenerators;
+        auto context = IRGenerator::DGeneratorContext{&this->_commandFactory};
+        return DataStructures::foldTree<
+            IRGenerators::generateAny, 
+            IRGenerators::preGenerateAny, 
+            IRGenerators::inGenerateAny
+        >(root, &context)->irCommands;
     }
 }
\ No newline at end of file
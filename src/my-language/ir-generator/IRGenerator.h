@@ -2,10 +2,11 @@
 #define MY_LANGUAGE_IR_GENERATOR_HH
 
 #include "TIRCommand.h"
-#include "../../components/data_structures/FoldableNode.h"
-#include "../../components/data_structures/LinkedMap.h"
+#include "../../components/data_structures/TreeFold.h"
+#include "../../components/data_structures/ScopedSymbolTable.h"
 #include "../../components/data_structures/BatchStack.h"
 #include "IRCommandFactory.h"
+#include "../parser/NodeKinds.h"
 #include <map>
 #include <stack>
 #include <set>
@@ -19,33 +20,16 @@ namespace MyLanguage {
      */
     class IRGenerator {
         public:
-            using TExpression = std::shared_ptr<Expression>;
-            struct DGeneratorContext;
-
-            /**
-             * Type of a function that is used for generating the IR for a specific expression type. 
-             * The function takes as its first input the this pointer pointing to the IRGenerator class. 
-             * The second variable is the Expression that the IR code is being generated for. 
-             * The third variable is a list of the results returned by the expression's children upon 
-             * having their IR code generated.
-             */
-            using TIRGenerator = std::function<
-                DGeneratorContext*(
-                    DGeneratorContext*,
-                    TExpression
-                )
-            >;
-
+            using TExpression = Expression*;
             /**
              * Type of the context object being passed around when generating 
              * IR commands from the abstract syntax tree by folding over it.
              */
             struct DGeneratorContext {
-                std::map<std::string, TIRGenerator>* irGenerators {nullptr};
                 IRCommandFactory* commandFactory {nullptr};
                 DataStructures::BatchStack<std::string> variableStack {};
                 DataStructures::BatchStack<std::string> labelStack {};
-                DataStructures::LinkedMap<std::string> symbolTable {};
+                DataStructures::ScopedSymbolTable<std::string> symbolTable {};
                 std::vector<TIRCommand> irCommands {};
                 DataStructures::BatchStack<std::string> loopLabelStack {};
                 DataStructures::BatchStack<std::string> loopVariableStack {};
@@ -56,13 +40,8 @@ namespace MyLanguage {
              * Generate the resulting IR commands from the given abstract syntax tree.
              */
             std::vector<TIRCommand> generate(TExpression root);
-            /**
-             * Map of the IR generating functions for each parse tree expression type.
-             */
-            std::map<std::string, TIRGenerator>& irGenerators();
         private:
             IRCommandFactory _commandFactory;
-            std::map<std::string, TIRGenerator> _irGenerators;
     };
 };
 
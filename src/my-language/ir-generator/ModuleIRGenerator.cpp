@@ -9,7 +9,7 @@ std::map<std::string, std::vector<MyLanguage::TIRCommand>> MyLanguage::ModuleIRG
 )
 {
     auto irCommands = std::map<std::string, std::vector<MyLanguage::TIRCommand>>{};
-	auto functions = moduleExpression->children();
+	std::vector<Expression*> functions = moduleExpression->children();
     std::for_each(functions.begin(), functions.end(), [&irCommands, this](auto f) {
         irCommands.insert({f->subTypes().at("name"), this->_generator.generate(f)});
     });
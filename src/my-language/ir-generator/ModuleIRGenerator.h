@@ -2,8 +2,7 @@
 #define MY_LANGUAGE_MODULE_IR_GENERATOR_HH
 
 #include "TIRCommand.h"
-#include "../../components/data_structures/FoldableNode.h"
-#include "../../components/data_structures/LinkedMap.h"
+#include "../../components/data_structures/TreeFold.h"
 #include "../../components/data_structures/BatchStack.h"
 #include "IRCommandFactory.h"
 #include "IRGenerator.h"
@@ -10,7 +10,7 @@
 
 namespace MyLanguage {
     using TIRVariable = std::string;
-    using TIRCommand = std::shared_ptr<Expression>;
+    using TIRCommand = Expression*;
     using TParams = std::vector<std::variant<TIRVariable, std::vector<TIRVariable>>>;
     /**
      * A command in the IR language.
@@ -6,6 +6,9 @@
 #include "../../tokenizer/Tokenizer.h"
 
 namespace Test {
+    // The expressions of all tests live as long as the test program.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
     auto parser = MyLanguage::Parser{};
     auto tokenizer = Tokenizer{};
     auto generator = MyLanguage::IRGenerator{};
@@ -13,7 +16,8 @@ namespace Test {
 
 TEST_CASE("generate") {
     auto input = "1 + 2 * 2;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
     auto root = Test::parser.parse(tokens, 0);
     auto irCommands = Test::generator.generate(root);
 
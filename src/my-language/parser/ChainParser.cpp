@@ -1,4 +1,5 @@
 #include "ChainParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::ChainParser::ChainParser(
     OperatedChainParser* operatedChainParser,
@@ -26,16 +27,16 @@ MyLanguage::ChainParser::ChainParser(
             "chain", 
             ";", 
             *(this->_mapParser),
-            [](std::vector<DToken>& tokens, int position) {
+            [closingBrace = Tokenization::Symbols::id("}")](std::vector<DToken>& tokens, int position) {
                 if (position > 0 && position < (int) (tokens.size())) {
                     return (
-                        tokens.at(position).value == "}" || 
-                        tokens.at(position - 1).value == "}"
+                        tokens.at(position).symbol == closingBrace || 
+                        tokens.at(position - 1).symbol == closingBrace
                     );
                 } else if (position < (int) (tokens.size())) {
-                    return tokens.at(position).value == "}";
+                    return tokens.at(position).symbol == closingBrace;
                 } else if (position > 0) {
-                    return tokens.at(position - 1).value == "}";
+                    return tokens.at(position - 1).symbol == closingBrace;
                 } else {
                     return false;
                 }
@@ -44,11 +45,16 @@ MyLanguage::ChainParser::ChainParser(
     );
 }
 
-std::shared_ptr<Expression> MyLanguage::ChainParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::ChainParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-    return this->_chainParser->parse(tokens, position);
+    return this->_chainParser->tryParse(tokens, position);
 }
 
 MapParser* MyLanguage::ChainParser::mapParser() {
     return this->_mapParser.get();
+}
+
+Parsing::FirstSet MyLanguage::ChainParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_chainParser.get());
 }
\ No newline at end of file
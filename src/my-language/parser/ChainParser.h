@@ -12,8 +12,10 @@ namespace MyLanguage {
     class ChainParser: public IParseable {
         public:
             ChainParser(OperatedChainParser* operatedChainParser, IParseable* typeParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
             MapParser* mapParser();
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             OperatedChainParser* _operatedChainParser;
             std::unique_ptr<Parsing::ChainParser> _chainParser;
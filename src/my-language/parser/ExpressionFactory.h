@@ -17,18 +17,18 @@ namespace MyLanguage {
             /**
              * Create a new function parameter expression.
              */
-            std::shared_ptr<Expression> createFunctionParameter(
+            Expression* createFunctionParameter(
                 std::string name,
                 std::string type
             );
             /**
              * Create a new function expression.
              */
-            std::shared_ptr<Expression> createFunction(
+            Expression* createFunction(
                 std::string name,
                 std::string returnType,
-                std::vector<std::shared_ptr<Expression>> parameterExpressions,
-                std::vector<std::shared_ptr<Expression>> definitionExpressions
+                std::vector<Expression*> parameterExpressions,
+                std::vector<Expression*> definitionExpressions
             );
         private:
             
@@ -1,4 +1,5 @@
 #include "FunctionCallParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::FunctionCallParser::FunctionCallParser(IParseable* identifierParser, IParseable& parameterParser):
     _identifierParser(identifierParser), _parameterParser(parameterParser)
@@ -28,27 +29,30 @@ MyLanguage::FunctionCallParser::FunctionCallParser(IParseable* identifierParser,
     );
 }
 
-std::shared_ptr<Expression> MyLanguage::FunctionCallParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::FunctionCallParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	auto functionExpression = this->_parser->parse(tokens, position);
+    auto parseResult = this->_parser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+	auto functionExpression = Expression::copy(parseResult.expression());
 
     // Switch the function name to be just a sub-type of the function expression 
     // instead of a proper child identifier expression.
     auto identifier = functionExpression->children().at(0);
     Expression::removeChild(functionExpression, identifier);
-    functionExpression->subTypes().insert({"name", identifier->rootToken().value});
+    functionExpression->subTypes().insert({"name", std::string{identifier->rootToken().value()}});
 
     // Next, we lift the individual argument expressions to become direct children of the function expression.
     
     auto argumentList = functionExpression->children().at(0);
     // Copy the children of the argument list expression.
-    std::vector<std::shared_ptr<Expression>> arguments = argumentList->children();
-    // Change each child of the argument list expression to be a child of the function expression.
+    std::vector<Expression*> arguments = argumentList->children();
+    // Make each child of the argument list expression a child of the function expression too.
     std::for_each(
         arguments.begin(), 
         arguments.end(), 
-        [&argumentList, &functionExpression](std::shared_ptr<Expression> argument) {
-            Expression::removeChild(argumentList, argument);
+        [&functionExpression](Expression* argument) {
             Expression::addChild(functionExpression, argument);
         }
     );
@@ -59,3 +63,8 @@ std::shared_ptr<Expression> MyLanguage::FunctionCallParser::parse(std::vector<DT
 
     return functionExpression;
 }
+
+Parsing::FirstSet MyLanguage::FunctionCallParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_parser.get());
+}
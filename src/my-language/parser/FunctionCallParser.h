@@ -18,7 +18,9 @@ namespace MyLanguage {
     class FunctionCallParser: public IParseable {
         public:
             FunctionCallParser(IParseable* identifierParser, IParseable& parameterParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             IParseable* _identifierParser;
             IParseable& _parameterParser;
@@ -1,4 +1,5 @@
 #include "FunctionParameterParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::FunctionParameterParser::FunctionParameterParser(IParseable* typeParser)
 {
@@ -20,9 +21,13 @@ MyLanguage::FunctionParameterParser::FunctionParameterParser(IParseable* typePar
     );
 }
 
-std::shared_ptr<Expression> MyLanguage::FunctionParameterParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::FunctionParameterParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-    auto expression = this->_skeletonParser->parse(tokens, position);
+    auto parseResult = this->_skeletonParser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+    auto expression = Expression::copy(parseResult.expression());
 
     // We want to change the parameter name and type into sub-types of the expression 
     // instead of proper child expressions.
@@ -46,3 +51,8 @@ std::shared_ptr<Expression> MyLanguage::FunctionParameterParser::parse(std::vect
 
     return expression;
 }
+
+Parsing::FirstSet MyLanguage::FunctionParameterParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_skeletonParser.get());
+}
@@ -23,7 +23,9 @@ namespace MyLanguage {
     class FunctionParameterParser: public IParseable {
         public:
             FunctionParameterParser(IParseable* typeParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::unique_ptr<LiteralParser> _identifierParser;
             std::unique_ptr<Parsing::SkeletonParser> _skeletonParser;
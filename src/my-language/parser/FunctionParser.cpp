@@ -1,4 +1,5 @@
 #include "FunctionParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::FunctionParser::FunctionParser(
     IParseable* identifierParser, 
@@ -72,15 +73,19 @@ MyLanguage::FunctionParser::FunctionParser(
     this->_statementParser->setWildCardParser(baseStatementParser);
 }
 
-std::shared_ptr<Expression> MyLanguage::FunctionParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::FunctionParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	auto functionExpression = this->_parser->parse(tokens, position);
+    auto parseResult = this->_parser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+	auto functionExpression = Expression::copy(parseResult.expression());
 
     // Switch the function name to be just a sub-type of the function expression 
     // instead of a proper child identifier expression.
     auto identifier = functionExpression->children().at(0);
     Expression::removeChild(functionExpression, identifier);
-    functionExpression->subTypes().insert({"name", identifier->rootToken().value});
+    functionExpression->subTypes().insert({"name", std::string{identifier->rootToken().value()}});
 
     // If the function has a return type specified.
     if (functionExpression->children().at(1)->type() == "type") {
@@ -101,4 +106,9 @@ std::shared_ptr<Expression> MyLanguage::FunctionParser::parse(std::vector<DToken
     functionExpression->subTypes().insert({"returns-amount", std::to_string(returns)});
 
     return functionExpression;
+}
+
+Parsing::FirstSet MyLanguage::FunctionParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_parser.get());
 }
\ No newline at end of file
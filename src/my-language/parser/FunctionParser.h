@@ -25,7 +25,9 @@ namespace MyLanguage {
                 IParseable* baseStatementParser,
                 IParseable* typeParser
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             IParseable* _identifierParser;
             std::unique_ptr<MyLanguage::FunctionParameterParser> _parameterParser;
@@ -1,4 +1,5 @@
 #include "IfParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::IfParser::IfParser(OperatedChainParser* operatedChainParser)
 {
@@ -21,7 +22,12 @@ MyLanguage::IfParser::IfParser(OperatedChainParser* operatedChainParser)
     );
 }
 
-std::shared_ptr<Expression> MyLanguage::IfParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::IfParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-	return this->_skeletonParser->parse(tokens, position);
+	return this->_skeletonParser->tryParse(tokens, position);
+}
+
+Parsing::FirstSet MyLanguage::IfParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_skeletonParser.get());
 }
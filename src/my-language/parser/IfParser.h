@@ -8,7 +8,9 @@ namespace MyLanguage {
     class IfParser: public IParseable {
         public:
             IfParser(OperatedChainParser* operatedChainParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::unique_ptr<Parsing::SkeletonParser> _skeletonParser;
     };
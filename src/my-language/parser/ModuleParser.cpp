@@ -1,4 +1,11 @@
 #include "ModuleParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
+#include "../../components/parsing/ExpressionArena.h"
+
+namespace {
+    // The least amount of function definitions worth parsing on several threads.
+    const int fewestFunctionsAhead = 2;
+}
 
 MyLanguage::ModuleParser::ModuleParser(
     IParseable* statementParser,
@@ -15,9 +22,9 @@ MyLanguage::ModuleParser::ModuleParser(
             "module", 
             ";", 
             *(this->_moduleStatementParser),
-            [](std::vector<DToken>& tokens, int position) {
+            [closingBrace = Tokenization::Symbols::id("}")](std::vector<DToken>& tokens, int position) {
                 if (position > 0) {
-                    return tokens.at(position - 1).value == "}";
+                    return tokens.at(position - 1).symbol == closingBrace;
                 } else {
                     return false;
                 }
@@ -42,10 +49,128 @@ MyLanguage::ModuleParser::ModuleParser(
 
 }
 
-std::shared_ptr<Expression> MyLanguage::ModuleParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::ModuleParser::_tryParse(std::vector<DToken>& tokens, int position)
+{
+    auto session = Parsing::ParseSession::current();
+    if (this->_threadPool != nullptr && session != nullptr) {
+        this->_parseFunctionsAhead(tokens, position, *session);
+    }
+    auto parseResult = this->_moduleParser->tryParse(tokens, position);
+    if (session != nullptr) {
+        session->discardPreparedResults();
+    }
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+    return this->_createMainFunction(parseResult.expression());
+}
+
+Expression* MyLanguage::ModuleParser::parse(TokenSequence& sequence)
 {
-    auto moduleExpression =  this->_moduleParser->parse(tokens, position);
-    auto moduleChildren = moduleExpression->children();
+    int prefetched = 0;
+    auto moduleExpression = this->_moduleParser->parse(sequence, [&prefetched](TokenSequence& sequence) {
+        prefetched = MyLanguage::ModuleParser::_prefetchStatement(sequence, prefetched);
+    });
+    return this->_createMainFunction(moduleExpression);
+}
+
+void MyLanguage::ModuleParser::setThreads(int threads)
+{
+    if (threads > 1) {
+        this->_threadPool = std::unique_ptr<Concurrency::ThreadPool>(new Concurrency::ThreadPool{threads});
+    } else {
+        this->_threadPool = nullptr;
+    }
+}
+
+void MyLanguage::ModuleParser::_parseFunctionsAhead(std::vector<DToken>& tokens, int position, Parsing::ParseSession& session)
+{
+    auto functionPositions = MyLanguage::ModuleParser::_findFunctions(tokens, position);
+    if ((int) functionPositions.size() < fewestFunctionsAhead) {
+        return;
+    }
+
+    // Each thread parses into an arena and a session of its own. A definition that fails to 
+    // parse is left to the parse of the module, which then reports the failure as usual.
+    int threads = this->_threadPool->threads();
+    auto arenas = std::vector<std::unique_ptr<Parsing::ExpressionArena>>{};
+    for (int thread = 0; thread < threads; thread++) {
+        arenas.push_back(std::unique_ptr<Parsing::ExpressionArena>(new Parsing::ExpressionArena{}));
+    }
+    auto results = std::vector<std::optional<Parsing::ParseResult>>(functionPositions.size());
+    bool memoize = session.memoizes();
+    this->_threadPool->forEach((int) functionPositions.size(), [&](int index, int thread) {
+        auto arenaScope = Parsing::ExpressionArena::Scope{*arenas[thread]};
+        auto threadSession = Parsing::ParseSession{memoize};
+        auto sessionScope = Parsing::ParseSession::Scope{threadSession};
+        try {
+            auto result = this->_moduleStatementParser->tryParse(tokens, functionPositions[index]);
+            if (result.succeeded()) {
+                results[index] = result;
+            }
+        } catch (std::exception&) {
+        }
+    });
+
+    // The trees now belong to the module, and the parse of the module takes them over in source order.
+    for (auto& arena : arenas) {
+        Parsing::ExpressionArena::current().adopt(std::move(arena));
+    }
+    for (int index = 0; index < (int) functionPositions.size(); index++) {
+        if (results[index].has_value()) {
+            session.prepareResult(this->_moduleStatementParser.get(), functionPositions[index], *results[index]);
+        }
+    }
+}
+
+std::vector<int> MyLanguage::ModuleParser::_findFunctions(std::vector<DToken>& tokens, int position)
+{
+    static const int functionKeyword = Tokenization::Symbols::id("function-keyword");
+    static const int separator = Tokenization::Symbols::id(";");
+    static const int openingParenthesis = Tokenization::Symbols::id("(");
+    static const int closingParenthesis = Tokenization::Symbols::id(")");
+    static const int openingBrace = Tokenization::Symbols::id("{");
+    static const int closingBrace = Tokenization::Symbols::id("}");
+
+    // A function definition ends with the brace closing its body, and other top-level statements 
+    // end at a separator outside of any parentheses or braces. Where this misjudges the end of 
+    // a statement, the following definition is simply not parsed ahead.
+    auto functionPositions = std::vector<int>{};
+    int current = position;
+    int end = (int) tokens.size();
+    while (current < end && tokens[current].kind != Tokenization::Symbols::end) {
+        bool isFunction = tokens[current].kind == functionKeyword;
+        if (isFunction) {
+            functionPositions.push_back(current);
+        }
+        int depth = 0;
+        bool inBody = false;
+        for (; current < end && tokens[current].kind != Tokenization::Symbols::end; current++) {
+            int symbol = tokens[current].symbol;
+            if (symbol == openingParenthesis || symbol == openingBrace) {
+                inBody = inBody || (isFunction && depth == 0 && symbol == openingBrace);
+                depth = depth + 1;
+            } else if (symbol == closingParenthesis || symbol == closingBrace) {
+                depth = depth - 1;
+                if (inBody && depth == 0) {
+                    current = current + 1;
+                    break;
+                }
+            } else if (symbol == separator && depth <= 0) {
+                break;
+            }
+        }
+        while (current < end && tokens[current].symbol == separator) {
+            current = current + 1;
+        }
+    }
+    return functionPositions;
+}
+
+Expression* MyLanguage::ModuleParser::_createMainFunction(Expression* moduleExpression)
+{
+    moduleExpression = Expression::copy(moduleExpression);
+    std::vector<Expression*> moduleChildren = moduleExpression->children();
 
     // First, we check that there is at most one top-level expression that is not a function definition.
     
@@ -53,13 +178,13 @@ std::shared_ptr<Expression> MyLanguage::ModuleParser::parse(std::vector<DToken>&
         return child->type() != "function";
     };
 
-    auto topLevelExpressions = std::vector<std::shared_ptr<Expression>>{};
+    auto topLevelExpressions = std::vector<Expression*>{};
     std::copy_if(moduleChildren.begin(), moduleChildren.end(), std::back_inserter(topLevelExpressions), isNotAFunction);
 
     // Next, we transform the top-level expressions into a function called 'main'. If no top-level expression 
     // is present, the 'main' function will have an empty definition.
 
-    std::shared_ptr<Expression> mainFunction;
+    Expression* mainFunction;
     if (topLevelExpressions.size() > 0) {
         mainFunction = (MyLanguage::ExpressionFactory{}).createFunction("main", "Unit", {}, topLevelExpressions);
         std::for_each(topLevelExpressions.begin(), topLevelExpressions.end(), [&moduleExpression](auto expression) {
@@ -72,4 +197,57 @@ std::shared_ptr<Expression> MyLanguage::ModuleParser::parse(std::vector<DToken>&
     Expression::addChild(moduleExpression, mainFunction);
 
     return moduleExpression;
+}
+
+int MyLanguage::ModuleParser::_prefetchStatement(TokenSequence& sequence, int prefetched)
+{
+    static const int functionKeyword = Tokenization::Symbols::id("function-keyword");
+    static const int separator = Tokenization::Symbols::id(";");
+    static const int openingParenthesis = Tokenization::Symbols::id("(");
+    static const int closingParenthesis = Tokenization::Symbols::id(")");
+    static const int openingBrace = Tokenization::Symbols::id("{");
+    static const int closingBrace = Tokenization::Symbols::id("}");
+
+    // A statement that starts before where the last scan ended also ends there at the latest, 
+    // since the scan would find the same end for it, so its tokens are in the window already.
+    if (sequence.position() < prefetched) {
+        return prefetched;
+    }
+
+    // A function definition ends with the brace closing its body. Other statements end at a 
+    // separator outside of any parentheses or braces, or where a function definition starts, 
+    // since function definitions only appear at the top level.
+    bool isFunction = sequence.peek().kind == functionKeyword;
+    bool inBody = false;
+    int depth = 0;
+    int distance = 0;
+    for (; sequence.peek(distance).kind != Tokenization::Symbols::end; distance++) {
+        int kind = sequence.peek(distance).kind;
+        int symbol = sequence.peek(distance).symbol;
+        if (kind == functionKeyword && distance > 0 && depth <= 0) {
+            break;
+        } else if (symbol == openingParenthesis || symbol == openingBrace) {
+            inBody = inBody || (isFunction && depth == 0 && symbol == openingBrace);
+            depth = depth + 1;
+        } else if (symbol == closingParenthesis || symbol == closingBrace) {
+            depth = depth - 1;
+            if (inBody && depth == 0) {
+                distance = distance + 1;
+                break;
+            }
+        } else if (symbol == separator && depth <= 0) {
+            break;
+        }
+    }
+    // The chain also skips the separators that follow and looks at the token after them.
+    while (sequence.peek(distance).symbol == separator) {
+        distance = distance + 1;
+    }
+    sequence.peek(distance);
+    return sequence.position() + distance;
+}
+
+Parsing::FirstSet MyLanguage::ModuleParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_moduleParser.get());
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "../../components/parsing/SkeletonParser.h"
 #include "../../components/parsing/OperatedChainParser.h"
 #include "../../components/parsing/Expression.h"
+#include "../../components/concurrency/ThreadPool.h"
 #include "ChainParser.h"
 #include "FunctionParser.h"
 #include "ExpressionFactory.h"
@@ -20,11 +21,42 @@ namespace MyLanguage {
                 IParseable* identifierParser,
                 IParseable* typeParser 
             );
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            using IParseable::parse;
+            /**
+             * Parses the module from a streamed sequence, one top-level statement at a time.
+             */
+            Expression* parse(TokenSequence& sequence);
+            /**
+             * Sets the amount of threads parsing the function definitions of a module 
+             * side by side. With more than one, the definitions are found by matching 
+             * braces and parsed ahead of the rest of the module, which then takes them 
+             * over in source order. Only applies to modules parsed from all of their tokens.
+             */
+            void setThreads(int threads);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::unique_ptr<Parsing::ChainParser> _moduleParser;
             std::unique_ptr<MapParser> _moduleStatementParser;
             std::unique_ptr<MyLanguage::FunctionParser> _functionParser;
+            std::unique_ptr<Concurrency::ThreadPool> _threadPool;
+            Expression* _createMainFunction(Expression* moduleExpression);
+            /**
+             * Parses the top-level function definitions from the position onwards on the threads 
+             * of the pool and prepares the results in the session for the parse of the module.
+             */
+            void _parseFunctionsAhead(std::vector<DToken>& tokens, int position, Parsing::ParseSession& session);
+            /**
+             * Finds where the top-level function definitions from the position onwards start.
+             */
+            static std::vector<int> _findFunctions(std::vector<DToken>& tokens, int position);
+            /**
+             * Pulls the tokens of the next top-level statement, and the token after them, into 
+             * the window of the sequence. Returns the position up to which the window was 
+             * scanned, which is given back with the next statement to avoid scanning it again.
+             */
+            static int _prefetchStatement(TokenSequence& sequence, int prefetched);
     };
 };
 
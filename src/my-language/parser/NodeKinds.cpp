@@ -0,0 +1,53 @@
+#include "NodeKinds.h"
+#include <vector>
+
+namespace {
+    struct DNodeKindName {
+        const char* type;
+        MyLanguage::ENodeKind kind;
+    };
+    const DNodeKindName nodeKindNames[] = {
+        {"module", MyLanguage::ENodeKind::module},
+        {"function", MyLanguage::ENodeKind::function},
+        {"function-definition", MyLanguage::ENodeKind::functionDefinition},
+        {"function-parameter-list", MyLanguage::ENodeKind::functionParameterList},
+        {"function-parameter", MyLanguage::ENodeKind::functionParameter},
+        {"function-call", MyLanguage::ENodeKind::functionCall},
+        {"variable-declaration", MyLanguage::ENodeKind::variableDeclaration},
+        {"identifier", MyLanguage::ENodeKind::identifier},
+        {"number", MyLanguage::ENodeKind::number},
+        {"boolean", MyLanguage::ENodeKind::boolean},
+        {"chain", MyLanguage::ENodeKind::chain},
+        {"block", MyLanguage::ENodeKind::block},
+        {"parenthetical", MyLanguage::ENodeKind::parenthetical},
+        {"binary-operator", MyLanguage::ENodeKind::binaryOperator},
+        {"unary-operator", MyLanguage::ENodeKind::unaryOperator},
+        {"assignment", MyLanguage::ENodeKind::assignment},
+        {"if", MyLanguage::ENodeKind::ifExpression},
+        {"while", MyLanguage::ENodeKind::whileExpression},
+        {"return", MyLanguage::ENodeKind::returnExpression},
+        {"break", MyLanguage::ENodeKind::breakExpression},
+        {"continue", MyLanguage::ENodeKind::continueExpression}
+    };
+
+    // The kinds by the interned ids of the expression types. Types interned after the 
+    // vector was built are not node types of the language, so they fall outside of it.
+    std::vector<MyLanguage::ENodeKind> createNodeKinds() {
+        auto kinds = std::vector<MyLanguage::ENodeKind>{};
+        for (auto& name : nodeKindNames) {
+            auto id = Parsing::Names::id(name.type);
+            if (id >= (int) kinds.size()) {
+                kinds.resize(id + 1, MyLanguage::ENodeKind::other);
+            }
+            kinds[id] = name.kind;
+        }
+        return kinds;
+    }
+}
+
+MyLanguage::ENodeKind MyLanguage::NodeKinds::of(Expression* expression)
+{
+    static const std::vector<ENodeKind> kinds = createNodeKinds();
+    auto id = expression->kind();
+    return id >= 0 && id < (int) kinds.size() ? kinds[id] : ENodeKind::other;
+}
@@ -0,0 +1,51 @@
+#ifndef MY_LANGUAGE_NODE_KINDS_HH
+#define MY_LANGUAGE_NODE_KINDS_HH
+
+#include "../../components/parsing/Expression.h"
+
+namespace MyLanguage {
+    /**
+     * The kinds of nodes in the abstract syntax tree of our language, as a dense 
+     * enumeration that passes over the tree can switch on.
+     */
+    enum class ENodeKind: unsigned char {
+        other,
+        module,
+        function,
+        functionDefinition,
+        functionParameterList,
+        functionParameter,
+        functionCall,
+        variableDeclaration,
+        identifier,
+        number,
+        boolean,
+        chain,
+        block,
+        parenthetical,
+        binaryOperator,
+        unaryOperator,
+        assignment,
+        ifExpression,
+        whileExpression,
+        returnExpression,
+        breakExpression,
+        continueExpression
+    };
+
+    /**
+     * Finds the kinds of expressions. The kind of an expression is looked up from a 
+     * vector indexed by the interned id of the expression's type, so no strings are 
+     * compared.
+     */
+    class NodeKinds {
+        public:
+            /**
+             * The kind of the given expression, or ENodeKind::other if its type is not 
+             * one of the node types of our language.
+             */
+            static ENodeKind of(Expression* expression);
+    };
+};
+
+#endif
@@ -1,12 +1,22 @@
 #include "Parser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 #include <iostream>
 
-MyLanguage::Parser::Parser() {
+MyLanguage::Parser::Parser():
+    _memoize(true) {
+    // The attributes of our trees besides the names and openness known to all parsers. Number 
+    // literals are values rather than names, so that they are not interned.
+    Expression::registerAttribute("value-type", Expression::EAttributeSlot::type);
+    Expression::registerAttribute("return-type", Expression::EAttributeSlot::type);
+    Expression::registerAttribute("explicit-type", Expression::EAttributeSlot::type);
+    Expression::registerAttribute("returns-amount", Expression::EAttributeSlot::value);
+    Expression::registerAttribute("value", Expression::EAttributeSlot::value);
+
     // First, we create the parsers.
 
     this->_mapParser = std::unique_ptr<MapParser>(new MapParser{});
     this->_identifierLiteralParser = std::unique_ptr<LiteralParser>(new LiteralParser{"identifier"});
-    this->_numberLiteralParser = std::unique_ptr<LiteralParser>(new LiteralParser{"number"});
+    this->_numberLiteralParser = std::unique_ptr<LiteralParser>(new LiteralParser{"number", "value"});
     this->_booleanLiteralParser = std::unique_ptr<LiteralParser>(new LiteralParser{"boolean"});
     this->_typeParser = std::unique_ptr<MyLanguage::TypeParser>(new MyLanguage::TypeParser{});
 
@@ -21,7 +31,7 @@ MyLanguage::Parser::Parser() {
     this->_operatedChainParser = std::unique_ptr<OperatedChainParser>(
         new OperatedChainParser{
             *(this->_mapParser), 
-            std::map<std::string, IParseable*>{
+            std::map<std::string, BinaryParser*>{
                 {"binary-operator", this->_binaryParser.get()},
                 {"minus", this->_binaryParser.get()},
                 {"asterisk", this->_binaryParser.get()}
@@ -109,9 +119,21 @@ MyLanguage::Parser::Parser() {
             {"=", 1}
         }
     );
+
+    // With the grammar complete, we find out which tokens each of its parsers can start with.
+
+    Parsing::GrammarAnalysis::analyze(*this);
+}
+
+Parsing::ParseResult MyLanguage::Parser::_tryParse(std::vector<DToken>& tokens, int position) {
+    return this->_moduleParser->tryParse(tokens, position);
 }
 
-std::shared_ptr<Expression> MyLanguage::Parser::parse(std::vector<DToken>& tokens, int position) {
+Expression* MyLanguage::Parser::parse(std::vector<DToken>& tokens, int position) {
+    // Parse in the current session, or in one of our own if there is none.
+    auto session = Parsing::ParseSession{this->_memoize};
+    auto current = Parsing::ParseSession::current();
+    auto scope = Parsing::ParseSession::Scope{current != nullptr ? *current : session};
 	auto root = this->_moduleParser->parse(tokens, position);
     if (root->endPos() != ((int) tokens.size()) - 1) {
         throw std::runtime_error(
@@ -120,4 +142,32 @@ std::shared_ptr<Expression> MyLanguage::Parser::parse(std::vector<DToken>& token
         );
     }
     return root;
-}
\ No newline at end of file
+}
+
+Expression* MyLanguage::Parser::parse(TokenSequence& sequence) {
+    // Parse in the current session, or in one of our own if there is none.
+    auto session = Parsing::ParseSession{this->_memoize};
+    auto current = Parsing::ParseSession::current();
+    auto scope = Parsing::ParseSession::Scope{current != nullptr ? *current : session};
+	auto root = this->_moduleParser->parse(sequence);
+    if (sequence.peek().kind != Tokenization::Symbols::end) {
+        throw std::runtime_error(
+            std::string("Error during parsing: Nothing parseable encountered beyond ") + 
+            root->endLocation().toString()
+        );
+    }
+    return root;
+}
+
+void MyLanguage::Parser::setMemoization(bool memoize) {
+    this->_memoize = memoize;
+}
+
+void MyLanguage::Parser::setThreads(int threads) {
+    this->_moduleParser->setThreads(threads);
+}
+
+Parsing::FirstSet MyLanguage::Parser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_moduleParser.get());
+}
@@ -25,7 +25,31 @@ namespace MyLanguage {
     class Parser: public IParseable {
         public:
             Parser();
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            /**
+             * Parses a whole module, throwing if it fails to parse or does not span all tokens.
+             */
+            Expression* parse(std::vector<DToken>& tokens, int position);
+            /**
+             * Parses a module from a streamed sequence, which lets parsing start before the 
+             * whole source has been tokenized and only keeps the tokens of one top-level 
+             * statement at a time. Produces the same tree as parsing all tokens at once.
+             */
+            Expression* parse(TokenSequence& sequence);
+            /**
+             * Whether parsing memoizes the results of every rule at every position. Only 
+             * applies when parsing outside of a ParseSession, since a session decides it 
+             * itself. On by default.
+             */
+            void setMemoization(bool memoize);
+            /**
+             * Sets the amount of threads parsing the function definitions of a module side 
+             * by side, see ModuleParser::setThreads. The tree is the same whatever the amount. 
+             * One by default.
+             */
+            void setThreads(int threads);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::unique_ptr<MapParser> _mapParser;
             std::unique_ptr<LiteralParser> _identifierLiteralParser;
@@ -43,6 +67,7 @@ namespace MyLanguage {
             std::unique_ptr<MyLanguage::FunctionCallParser> _functionCallParser;
             std::unique_ptr<MyLanguage::ModuleParser> _moduleParser;
             std::unique_ptr<MyLanguage::TypeParser> _typeParser;
+            bool _memoize;
     };
 };
 
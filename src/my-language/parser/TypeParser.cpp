@@ -1,6 +1,8 @@
 #include "TypeParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
-MyLanguage::TypeParser::TypeParser()
+MyLanguage::TypeParser::TypeParser():
+    _asteriskSymbol(Tokenization::Symbols::id("*"))
 {
     this->_literalParser = std::unique_ptr<LiteralParser>(new LiteralParser{"identifier"});
     this->_parameterListParser = std::unique_ptr<Parsing::ListParser>(
@@ -34,28 +36,34 @@ MyLanguage::TypeParser::TypeParser()
     );
 }
 
-std::shared_ptr<Expression> MyLanguage::TypeParser::parse(std::vector<DToken>& tokens, int position)
+Parsing::ParseResult MyLanguage::TypeParser::_tryParse(std::vector<DToken>& tokens, int position)
 {
-    auto expression = this->_mainParser->parse(tokens, position);
+    auto parseResult = this->_mainParser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+    auto expression = parseResult.expression();
 
     // If the expression is wrapped in parentheses, we want to strip them.
     if (expression->type() == "parenthetical") {
-        auto typeExpression = expression->children().at(0);
+        auto typeExpression = Expression::copy(expression->children().at(0));
 
         auto& typeName = typeExpression->subTypes().at("name");
-        typeName = "(" + typeName + ")";
+        typeExpression->subTypes().insert_or_assign("name", "(" + typeName + ")");
         
         typeExpression->setStartPos(position);
         typeExpression->setEndPos(typeExpression->endPos() + 1);
         expression = typeExpression;
+    } else {
+        expression = Expression::copy(expression);
     }
 
     // Parse any potential following pointer asterisks.
     auto sequence = TokenSequence{tokens};
     sequence.setPosition(expression->endPos());
-    while (sequence.peek().value == "*") {
+    while (sequence.peek().symbol == this->_asteriskSymbol) {
         auto& typeName = expression->subTypes().at("name");
-        typeName = typeName + "*";
+        expression->subTypes().insert_or_assign("name", typeName + "*");
         sequence.consume();
     }
 
@@ -70,8 +78,8 @@ std::shared_ptr<Expression> MyLanguage::TypeParser::parse(std::vector<DToken>& t
                 if (!first) {
                     result = result + ", ";
                 }
-                return result + typeParam->subTypes().at("name");
                 first = false;
+                return result + typeParam->subTypes().at("name");
         }) + ")";
         auto returnType = expression->children().at(1)->subTypes().at("name");
         expression->subTypes().insert({"name", paramListTypes + " => " +  returnType});
@@ -83,4 +91,9 @@ std::shared_ptr<Expression> MyLanguage::TypeParser::parse(std::vector<DToken>& t
     expression->setType("type");
 
     return expression;
+}
+
+Parsing::FirstSet MyLanguage::TypeParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_mainParser.get());
 }
\ No newline at end of file
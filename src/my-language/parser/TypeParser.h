@@ -12,13 +12,16 @@ namespace MyLanguage {
     class TypeParser: public IParseable {
         public:
             TypeParser();
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
         std::unique_ptr<Parsing::ConflictParser> _mainParser;
         std::unique_ptr<LiteralParser> _literalParser;
         std::unique_ptr<Parsing::ParentheticalParser> _parentheticalParser;
         std::unique_ptr<Parsing::ListParser> _parameterListParser;
         std::unique_ptr<Parsing::SkeletonParser> _functionTypeParser;
+        int _asteriskSymbol;
     };
 };
 
@@ -1,4 +1,5 @@
 #include "VariableDeclarationParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
 
 MyLanguage::VariableDeclarationParser::VariableDeclarationParser(
     OperatedChainParser* operatedChainParser,
@@ -36,11 +37,12 @@ MyLanguage::VariableDeclarationParser::VariableDeclarationParser(
     };
 }
 
-std::shared_ptr<Expression> MyLanguage::VariableDeclarationParser::parse(
-    std::vector<DToken>& tokens, 
-    int position
-) {
-    auto expression = this->_conflictParser->parse(tokens, position);
+Parsing::ParseResult MyLanguage::VariableDeclarationParser::_tryParse(std::vector<DToken>& tokens, int position) {
+    auto parseResult = this->_conflictParser->tryParse(tokens, position);
+    if (!parseResult.succeeded()) {
+        return parseResult;
+    }
+    auto expression = Expression::copy(parseResult.expression());
     // If the expression is a typed variable declaration.
     if (expression->children().size() == 3) {
         // Change the type child expression into a subtype of the variable declaration.
@@ -51,7 +53,7 @@ std::shared_ptr<Expression> MyLanguage::VariableDeclarationParser::parse(
         expression->subTypes().insert({"value-type", "Any"});
     }
     // Set the proper subtype for the name of the declared variable.
-    expression->subTypes().insert({"name", expression->tokens().at(1).value});
+    expression->subTypes().insert({"name", std::string{expression->tokens().at(1).value()}});
     // Remove the identifier child expression.
     Expression::removeChild(expression, expression->children().at(0));
     return expression;
@@ -73,4 +75,9 @@ std::shared_ptr<Parsing::SkeletonParser> MyLanguage::VariableDeclarationParser::
         }
     );
     return skeletonParser;
+}
+
+Parsing::FirstSet MyLanguage::VariableDeclarationParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    return analysis.firstSet(this->_conflictParser.get());
 }
\ No newline at end of file
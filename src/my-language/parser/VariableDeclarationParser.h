@@ -9,7 +9,9 @@ namespace MyLanguage {
     class VariableDeclarationParser: public IParseable {
         public:
             VariableDeclarationParser(OperatedChainParser* operatedChainParser, IParseable* typeParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             std::shared_ptr<Parsing::SkeletonParser> _skeletonParser;
             std::shared_ptr<Parsing::SkeletonParser> _typedSkeletonParser;
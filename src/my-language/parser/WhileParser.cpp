@@ -1,7 +1,13 @@
 #include "WhileParser.h"
+#include "../../components/parsing/GrammarAnalysis.h"
+
+namespace {
+    // The bit of the context of a parse session that is set while parsing the body of a loop.
+    const int loopContext = 1;
+}
 
 MyLanguage::WhileParser::WhileParser(OperatedChainParser* operatedChainParser):
-    _operatedChainParser(operatedChainParser), _parseLevel(0) {
+    _operatedChainParser(operatedChainParser), _whileSymbol(Tokenization::Symbols::id("while")) {
     this->_breakParser = std::unique_ptr<Parsing::SkeletonParser>(
         new Parsing::SkeletonParser{
             "break", 
@@ -32,25 +38,28 @@ MyLanguage::WhileParser::WhileParser(OperatedChainParser* operatedChainParser):
             }
         }
     );
-}
 
-std::shared_ptr<Expression> MyLanguage::WhileParser::parse(std::vector<DToken>& tokens, int position)
-{
+    // Breaking and continuing are only parsed inside of loops.
     auto& mapParser = ((MapParser&) this->_operatedChainParser->parser());
+    mapParser.setContextualParser("break", this->_breakParser.get(), loopContext);
+    mapParser.setContextualParser("continue", this->_continueParser.get(), loopContext);
+}
 
-    if (this->_parseLevel == 0) {
-        mapParser.parsers().insert({"break", this->_breakParser.get()});
-        mapParser.parsers().insert({"continue", this->_continueParser.get()});
-    }
-    this->_parseLevel = this->_parseLevel + 1;
-
-	auto result = this->_mainParser->parse(tokens, position);
- 
-    this->_parseLevel = this->_parseLevel - 1;
-    if (this->_parseLevel == 0) {
-        mapParser.parsers().erase("break");
-        mapParser.parsers().erase("continue");
+Parsing::ParseResult MyLanguage::WhileParser::_tryParse(std::vector<DToken>& tokens, int position)
+{
+    // The rules for breaking and continuing are turned on by the context of the session, so that 
+    // parsers are not changed while parsing. Results parsed inside and outside of loops differ, 
+    // so they are memoized in contexts of their own too.
+    auto session = Parsing::ParseSession::current();
+    if (session == nullptr) {
+        auto loopSession = Parsing::ParseSession{false};
+        auto scope = Parsing::ParseSession::Scope{loopSession};
+        return this->_tryParse(tokens, position);
     }
+    int context = session->context();
+    session->setContext(context | loopContext);
+	auto result = this->_mainParser->tryParse(tokens, position);
+    session->setContext(context);
     return result;
 }
 
@@ -58,5 +67,17 @@ bool MyLanguage::WhileParser::canParseAt(std::vector<DToken>& tokens, int positi
 {
     auto sequence = TokenSequence{tokens};
     sequence.setPosition(position);
-    return sequence.peek().value == "while";
+    return sequence.peek().symbol == this->_whileSymbol;
+}
+
+bool MyLanguage::WhileParser::commitsAt(std::vector<DToken>& tokens, int position)
+{
+    return this->canParseAt(tokens, position);
+}
+
+Parsing::FirstSet MyLanguage::WhileParser::firstSet(Parsing::GrammarAnalysis& analysis)
+{
+    // The expression parser may start with breaking or continuing, since 
+    // its rules for them are in effect while parsing loops.
+    return analysis.firstSet(this->_mainParser.get());
 }
\ No newline at end of file
@@ -11,14 +11,20 @@ namespace MyLanguage {
     class WhileParser: public IParseable {
         public:
             WhileParser(OperatedChainParser* operatedChainParser);
-            std::shared_ptr<Expression> parse(std::vector<DToken>& tokens, int position);
             bool canParseAt(std::vector<DToken>& tokens, int position);
+            /**
+             * A while parser takes on every while loop, so a malformed loop is an error.
+             */
+            bool commitsAt(std::vector<DToken>& tokens, int position);
+            Parsing::FirstSet firstSet(Parsing::GrammarAnalysis& analysis);
+        protected:
+            Parsing::ParseResult _tryParse(std::vector<DToken>& tokens, int position);
         private:
             OperatedChainParser* _operatedChainParser;
             std::unique_ptr<Parsing::SkeletonParser> _mainParser;
             std::unique_ptr<LiteralParser> _continueParser;
             std::unique_ptr<Parsing::SkeletonParser> _breakParser;
-            int _parseLevel;
+            int _whileSymbol;
     };
 };
 
@@ -0,0 +1,193 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../tokenizer/Tokenizer.h"
+#include "../Parser.h"
+
+/**
+ * Guards the parser against blowing up on large inputs. For each family of inputs,
+ * such as long operator chains or deeply nested blocks, inputs of doubling size are
+ * parsed and the exponent of a power law is fitted to the time taken. The benchmark
+ * fails if the exponent of any family exceeds the budget, which is the exponent of
+ * n log n over the same sizes plus a margin for noise. A parser that is quadratic in
+ * some family shows an exponent close to 2, and an exponential one a far larger one.
+ *
+ * Most families parse a vector of all tokens. Streamed families parse a TokenSequence 
+ * over a TokenStream as the compiler does, so their times include tokenization, and 
+ * threaded families parse the function definitions of a module on several threads.
+ *
+ * Small inputs are parsed repeatedly until enough time has passed to measure.
+ * Nested families stay shallower than the others, since parsing them takes stack
+ * in proportion to their depth.
+ *
+ * Usage: Complexity.benchmark.out [doublings] [margin]
+ */
+
+// How the inputs of a family are parsed.
+enum class EParse {
+    tokens,
+    streamed,
+    threaded
+};
+
+// A family of inputs, generated from the amount of repeated units in them.
+struct DFamily {
+    std::string name;
+    int smallestSize;
+    std::function<std::string(int size)> create;
+    EParse parse = EParse::tokens;
+};
+
+// The amount of threads threaded families are parsed with.
+const int threads = 4;
+
+std::string repeat(const std::string& unit, int size) {
+    std::string input;
+    input.reserve(unit.size() * size);
+    for (int i = 0; i < size; i++) {
+        input += unit;
+    }
+    return input;
+}
+
+// Function definitions, which are not separated by semicolons, followed by a call.
+std::string createFunctions(int size) {
+    auto input = std::string{};
+    for (int i = 0; i < size; i++) {
+        input += "fun f" + std::to_string(i) + "(n: Int): Int { var y: Int = n; while y > 0 do { y = y - 1; }; return y; }\n";
+    }
+    return input + "f0(1);";
+}
+
+std::string createStatementChain(int size) {
+    return "var x: Int = 0;\n" + repeat("x = x + 1;\n", size);
+}
+
+std::vector<DFamily> createFamilies() {
+    return std::vector<DFamily>{
+        {"binary-chain", 256, [](int size) {
+            return "x = 1" + repeat(" + a * b - c", size) + ";";
+        }},
+        {"parentheses", 16, [](int size) {
+            return "x = " + repeat("(", size) + "1" + repeat(" + a)", size) + ";";
+        }},
+        {"blocks", 16, [](int size) {
+            return "x = " + repeat("{ var y = ", size) + "1" + repeat("; y } * b", size) + ";";
+        }},
+        {"ifs", 16, [](int size) {
+            return "x = " + repeat("if a then ", size) + "1" + repeat(" else c", size) + ";";
+        }},
+        {"whiles", 16, [](int size) {
+            return repeat("while a do { ", size) + "break;" + repeat(" };", size);
+        }},
+        {"statement-chain", 256, createStatementChain},
+        {"argument-list", 256, [](int size) {
+            return "f(a" + repeat(", b + 1", size) + ");";
+        }},
+        {"function-calls", 64, [](int size) {
+            return repeat("f(a, g(b, c), 1 + d, h(e), f, 2, 3, -x);\n", size);
+        }},
+        {"functions", 64, createFunctions},
+        {"streamed-statement-chain", 256, createStatementChain, EParse::streamed},
+        {"streamed-functions", 64, createFunctions, EParse::streamed},
+        {"streamed-blocks", 16, [](int size) {
+            return "x = " + repeat("{ var y = ", size) + "1" + repeat("; y } * b", size) + ";";
+        }, EParse::streamed},
+        {"threaded-functions", 64, createFunctions, EParse::threaded},
+        {"threaded-function-calls", 64, [](int size) {
+            return createFunctions(size) + repeat("f(a, g(b, c), 1 + d, h(e), f, 2, 3, -x);\n", size);
+        }, EParse::threaded}
+    };
+}
+
+// The least amount of time to spend parsing each input.
+const double minimumSeconds = 0.1;
+
+// Returns the average time taken by the given parse of an input.
+double measure(const std::function<void()>& parse) {
+    int repetitions = 0;
+    double seconds = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        auto arena = Parsing::ExpressionArena{};
+        auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+        parse();
+        repetitions++;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (seconds < minimumSeconds);
+    return seconds / repetitions;
+}
+
+// The slope of the least squares line through the points (log x, log y).
+double growthExponent(const std::vector<double>& xs, const std::vector<double>& ys) {
+    double n = xs.size(), sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    for (int i = 0; i < (int) xs.size(); i++) {
+        double x = std::log(xs[i]), y = std::log(ys[i]);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+    return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+}
+
+int main(int argc, char* argv[]) {
+    int doublings = argc > 1 ? std::atoi(argv[1]) : 6;
+    double margin = argc > 2 ? std::atof(argv[2]) : 0.25;
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto parser = MyLanguage::Parser{};
+    auto threadedParser = MyLanguage::Parser{};
+    threadedParser.setThreads(threads);
+    bool withinBudget = true;
+    std::cout << "family\tsize\ttokens\tseconds\ttokens/s" << std::endl;
+    for (auto& family : createFamilies()) {
+        auto tokenCounts = std::vector<double>{};
+        auto times = std::vector<double>{};
+        auto budgetTimes = std::vector<double>{};
+        for (int size = family.smallestSize, i = 0; i <= doublings; size *= 2, i++) {
+            auto input = Text::Source{family.create(size)};
+            auto tokens = tokenizer.tokenizer.tokenize(input);
+            auto parse = std::function<void()>{[&]() {
+                parser.parse(tokens, 0);
+            }};
+            if (family.parse == EParse::streamed) {
+                parse = [&]() {
+                    auto stream = Tokenization::TokenStream{tokenizer.tokenizer, input};
+                    auto sequence = TokenSequence{stream};
+                    parser.parse(sequence);
+                };
+            } else if (family.parse == EParse::threaded) {
+                parse = [&]() {
+                    threadedParser.parse(tokens, 0);
+                };
+            }
+            double seconds = measure(parse);
+            tokenCounts.push_back(tokens.size());
+            times.push_back(seconds);
+            budgetTimes.push_back(tokens.size() * std::log(tokens.size()));
+            std::cout
+                << family.name << "\t"
+                << size << "\t"
+                << tokens.size() << "\t"
+                << seconds << "\t"
+                << tokens.size() / seconds << std::endl;
+        }
+        double exponent = growthExponent(tokenCounts, times);
+        double budget = growthExponent(tokenCounts, budgetTimes) + margin;
+        bool fits = exponent <= budget;
+        withinBudget = withinBudget && fits;
+        std::cout
+            << family.name << "\tgrowth exponent " << exponent
+            << "\tbudget " << budget
+            << "\t" << (fits ? "ok" : "OVER BUDGET") << std::endl << std::endl;
+    }
+    if (!withinBudget) {
+        std::cout << "Parsing grows faster than n log n for some families." << std::endl;
+        return 1;
+    }
+    return 0;
+}
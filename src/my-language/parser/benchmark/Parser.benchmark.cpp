@@ -0,0 +1,187 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <malloc.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "../../tokenizer/Tokenizer.h"
+#include "../Parser.h"
+
+/**
+ * Measures the throughput of parsing programs of growing size, and the time it 
+ * takes to parse expressions of growing nesting depth with and without memoizing 
+ * the results of the parsing rules. Without memoization, parsing a left operand 
+ * twice at every level of nesting makes the time grow exponentially with depth.
+ * The hit rate and memory use of the memo table are reported for each input.
+ *
+ * Last, the same program is parsed over and over, each time into an arena of its 
+ * own, to show that the memory of each syntax tree is given back once its arena 
+ * is released: the resident memory of the process should stay flat. The memory 
+ * taken by the tree is reported as bytes per expression, counting the blocks of 
+ * the arena and whatever the expressions allocate on the heap on their own.
+ *
+ * Finally, the largest program is parsed with the function definitions spread over 
+ * a growing amount of threads, up to the amount of cores or at least four. The speedup 
+ * is relative to a single thread and can only exceed 1 on a machine with several cores.
+ *
+ * Usage: Parser.benchmark.out [largest size in megabytes] [deepest nesting]
+ */
+
+// A function definition and a few statements that are repeated to form the input. 
+// The name of the function is made unique for each repetition.
+const std::string snippetStart = "fun fibonacci";
+const std::string snippetEnd = 
+    "(n: Int): Int {\n"
+    "    var previous: Int = 0;\n"
+    "    var current: Int = 1;\n"
+    "    while n > 0 do {\n"
+    "        var next: Int = previous + current * 1;\n"
+    "        previous = current;\n"
+    "        current = next;\n"
+    "        n = n - 1;\n"
+    "    };\n"
+    "    return if not (previous == 0) or false then previous else -(1 % 7);\n"
+    "}\n";
+
+std::string createInput(size_t size) {
+    std::string input;
+    input.reserve(size + snippetStart.size() + snippetEnd.size() + 16);
+    for (int i = 0; input.size() < size; i++) {
+        input += snippetStart + std::to_string(i) + snippetEnd;
+    }
+    return input + "print_int(fibonacci0(10));\n";
+}
+
+// Nests an expression as the left operand of the next level, at the given depth.
+std::string createNestedInput(const std::string& family, int depth) {
+    std::string expression = "1";
+    for (int i = 0; i < depth; i++) {
+        if (family == "parentheses") {
+            expression = "(" + expression + " + a)";
+        } else if (family == "blocks") {
+            expression = "{ var x = " + expression + "; x } * b";
+        } else {
+            expression = "(if a then { while b do { " + expression + " }; } else c) - d";
+        }
+    }
+    return expression + ";\n";
+}
+
+// The longest time to spend on one input before giving up on deeper ones.
+const double maximumSeconds = 2;
+
+// The amount of times the same program is parsed when measuring memory.
+const int memoryRounds = 8;
+
+// Parses the tokens into an arena that is released after measuring.
+double parseInSession(MyLanguage::Parser& parser, std::vector<DToken>& tokens, Parsing::ParseSession& session) {
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+    auto scope = Parsing::ParseSession::Scope{session};
+    auto start = std::chrono::steady_clock::now();
+    auto root = parser.parse(tokens, 0);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// Parses the tokens into an arena and returns the heap memory taken per expression.
+double bytesPerExpression(MyLanguage::Parser& parser, std::vector<DToken>& tokens) {
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+    auto before = mallinfo2().uordblks;
+    {
+        auto session = Parsing::ParseSession{};
+        auto scope = Parsing::ParseSession::Scope{session};
+        parser.parse(tokens, 0);
+    }
+    auto after = mallinfo2().uordblks;
+    return (double) (after - before) / arena.size();
+}
+
+// The current resident memory of the process.
+double residentMegabytes() {
+    long pages = 0, residentPages = 0;
+    std::ifstream statm{"/proc/self/statm"};
+    statm >> pages >> residentPages;
+    return residentPages * (double) sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+int main(int argc, char* argv[]) {
+    double largestMegabytes = argc > 1 ? std::atof(argv[1]) : 4;
+    int deepestNesting = argc > 2 ? std::atoi(argv[2]) : 64;
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto parser = MyLanguage::Parser{};
+    std::cout << "megabytes\ttokens\tseconds\ttokens/s\thit rate\tmemo megabytes" << std::endl;
+    // Sizes grow fourfold from one kilobyte, ending with the largest size.
+    auto sizes = std::vector<double>{};
+    for (double megabytes = 1.0 / 1024; megabytes < largestMegabytes; megabytes *= 4) {
+        sizes.push_back(megabytes);
+    }
+    sizes.push_back(largestMegabytes);
+    for (double megabytes : sizes) {
+        auto input = Text::Source{createInput((size_t) (megabytes * 1024 * 1024))};
+        auto tokens = tokenizer.tokenizer.tokenize(input);
+        auto session = Parsing::ParseSession{};
+        double seconds = parseInSession(parser, tokens, session);
+        std::cout 
+            << input.text().size() / (1024.0 * 1024.0) << "\t" 
+            << tokens.size() << "\t" 
+            << seconds << "\t" 
+            << tokens.size() / seconds << "\t"
+            << session.hitRate() << "\t"
+            << session.memoBytes() / (1024.0 * 1024.0) << std::endl;
+    }
+
+    std::cout << std::endl << "nesting\tdepth\tmemoized\tseconds\thit rate\tmemo entries\tmemo megabytes" << std::endl;
+    for (std::string family : {"parentheses", "blocks", "conditionals"}) {
+        for (bool memoize : {true, false}) {
+            for (int depth = 4; depth <= deepestNesting; depth += 4) {
+                auto input = Text::Source{createNestedInput(family, depth)};
+                auto tokens = tokenizer.tokenizer.tokenize(input);
+                auto session = Parsing::ParseSession{memoize};
+                double seconds = parseInSession(parser, tokens, session);
+                std::cout 
+                    << family << "\t" 
+                    << depth << "\t" 
+                    << (memoize ? "yes" : "no") << "\t" 
+                    << seconds << "\t" 
+                    << session.hitRate() << "\t" 
+                    << session.memoEntries() << "\t" 
+                    << session.memoBytes() / (1024.0 * 1024.0) << std::endl;
+                if (seconds > maximumSeconds) {
+                    break;
+                }
+            }
+        }
+    }
+
+    std::cout << std::endl << "round\tseconds\tresident megabytes" << std::endl;
+    auto input = Text::Source{createInput((size_t) (largestMegabytes * 1024 * 1024))};
+    auto tokens = tokenizer.tokenizer.tokenize(input);
+    for (int round = 1; round <= memoryRounds; round++) {
+        auto session = Parsing::ParseSession{};
+        double seconds = parseInSession(parser, tokens, session);
+        std::cout << round << "\t" << seconds << "\t" << residentMegabytes() << std::endl;
+    }
+    std::cout << std::endl << "bytes per expression\t" << bytesPerExpression(parser, tokens) << std::endl;
+
+    std::cout << std::endl << "threads\tseconds\ttokens/s\tspeedup" << std::endl;
+    int mostThreads = std::max(4, (int) std::thread::hardware_concurrency());
+    double serialSeconds = 0;
+    for (int threads = 1; threads <= mostThreads; threads *= 2) {
+        auto threadedParser = MyLanguage::Parser{};
+        threadedParser.setThreads(threads);
+        auto session = Parsing::ParseSession{};
+        double seconds = parseInSession(threadedParser, tokens, session);
+        serialSeconds = threads == 1 ? seconds : serialSeconds;
+        std::cout 
+            << threads << "\t" 
+            << seconds << "\t" 
+            << tokens.size() / seconds << "\t" 
+            << serialSeconds / seconds << std::endl;
+    }
+    return 0;
+}
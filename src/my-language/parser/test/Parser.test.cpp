@@ -2,15 +2,20 @@
 #include "../../../libraries/doctest.h"
 #include "../Parser.h"
 #include "../../tokenizer/Tokenizer.h"
+#include "../../../components/parsing/GrammarAnalysis.h"
 
 namespace Test {
+    // The expressions of all tests live as long as the test program.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
     auto parser = MyLanguage::Parser{};
     auto tokenizer = Tokenizer{};
 }
 
 TEST_CASE("Boolean expression without inner parentheses") {
     auto input = "a and b or c and not d;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -18,19 +23,20 @@ TEST_CASE("Boolean expression without inner parentheses") {
     parseTree = parseTree->children().at(0);
     parseTree = parseTree->children().at(1)->children().at(0);
 
-    REQUIRE(parseTree->rootToken().value == "or");
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(1)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(1)->children().at(0)->rootToken().value == "c");
-    REQUIRE(parseTree->children().at(1)->children().at(1)->rootToken().value == "not");
-    REQUIRE(parseTree->children().at(1)->children().at(1)->children().at(0)->rootToken().value == "d");
+    REQUIRE(parseTree->rootToken().value() == "or");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(1)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(1)->children().at(0)->rootToken().value() == "c");
+    REQUIRE(parseTree->children().at(1)->children().at(1)->rootToken().value() == "not");
+    REQUIRE(parseTree->children().at(1)->children().at(1)->children().at(0)->rootToken().value() == "d");
 }
 
 TEST_CASE("Boolean expression with inner parentheses") {
     auto input = "a and (b or c) and not d;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -38,20 +44,21 @@ TEST_CASE("Boolean expression with inner parentheses") {
     parseTree = parseTree->children().at(0);
     parseTree = parseTree->children().at(1)->children().at(0);
 
-    REQUIRE(parseTree->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "(");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->rootToken().value == "or");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->children().at(0)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->children().at(1)->rootToken().value == "c");
-    REQUIRE(parseTree->children().at(1)->rootToken().value == "not");
-    REQUIRE(parseTree->children().at(1)->children().at(0)->rootToken().value == "d");
+    REQUIRE(parseTree->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "(");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->rootToken().value() == "or");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->children().at(0)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->children().at(0)->children().at(1)->rootToken().value() == "c");
+    REQUIRE(parseTree->children().at(1)->rootToken().value() == "not");
+    REQUIRE(parseTree->children().at(1)->children().at(0)->rootToken().value() == "d");
 }
 
 TEST_CASE("Nested block statement") {
     auto input = "{{a; b;} c}";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -63,14 +70,15 @@ TEST_CASE("Nested block statement") {
     REQUIRE(parseTree->children().at(0)->type() == "chain");
     REQUIRE(parseTree->children().at(0)->children().at(0)->type() == "block");
     REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->type() == "chain");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(1)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "c");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(1)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "c");
 }
 
 TEST_CASE("Variable declaration in block") {
     auto input = "{var a = b and c;}";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -81,14 +89,15 @@ TEST_CASE("Variable declaration in block") {
     REQUIRE(parseTree->type() == "block");
     REQUIRE(parseTree->children().at(0)->type() == "chain");
     REQUIRE(parseTree->children().at(0)->children().at(0)->type() == "variable-declaration");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(1)->rootToken().value == "c");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->children().at(1)->rootToken().value() == "c");
 }
 
 TEST_CASE("If then else") {
     auto input = "if a and b then c else d;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -96,16 +105,17 @@ TEST_CASE("If then else") {
     parseTree = parseTree->children().at(0);
     parseTree = parseTree->children().at(1);
     REQUIRE(parseTree->children().at(0)->type() == "if");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "c");
-    REQUIRE(parseTree->children().at(0)->children().at(2)->rootToken().value == "d");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "c");
+    REQUIRE(parseTree->children().at(0)->children().at(2)->rootToken().value() == "d");
 }
 
 TEST_CASE("If then") {
     auto input = "if a and b then c;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -113,15 +123,16 @@ TEST_CASE("If then") {
     parseTree = parseTree->children().at(0);
     parseTree = parseTree->children().at(1);
     REQUIRE(parseTree->children().at(0)->type() == "if");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "c");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "c");
 }
 
 TEST_CASE("While do") {
     auto input = "while a and b do c;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -129,15 +140,16 @@ TEST_CASE("While do") {
     parseTree = parseTree->children().at(0);
     parseTree = parseTree->children().at(1);
     REQUIRE(parseTree->children().at(0)->type() == "while");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "and");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value == "b");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "c");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "and");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->children().at(1)->rootToken().value() == "b");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "c");
 }
 
 TEST_CASE("Function call") {
     auto input = "f(a, b);";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -148,13 +160,14 @@ TEST_CASE("Function call") {
     REQUIRE(parseTree->type() == "function-call");
     REQUIRE(parseTree->subTypes().at("name") == "f");
     REQUIRE(parseTree->children().size() == 2);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(1)->rootToken().value == "b");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(1)->rootToken().value() == "b");
 }
 
 TEST_CASE("Function call with inner operated chain expression") {
     auto input = "f(a + b);";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -165,14 +178,15 @@ TEST_CASE("Function call with inner operated chain expression") {
     REQUIRE(parseTree->type() == "function-call");
     REQUIRE(parseTree->subTypes().at("name") == "f");
     REQUIRE(parseTree->children().size() == 1);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "+");
-    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value == "a");
-    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value == "b");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "+");
+    REQUIRE(parseTree->children().at(0)->children().at(0)->rootToken().value() == "a");
+    REQUIRE(parseTree->children().at(0)->children().at(1)->rootToken().value() == "b");
 }
 
 TEST_CASE("Unary minus expression") {
     auto input = "-1;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -183,12 +197,13 @@ TEST_CASE("Unary minus expression") {
     REQUIRE(parseTree->type() == "unary-operator");
     REQUIRE(parseTree->subTypes().at("name") == "-");
     REQUIRE(parseTree->children().size() == 1);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "1");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "1");
 }
 
 TEST_CASE("Subtraction") {
     auto input = "2 - 1;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -199,13 +214,14 @@ TEST_CASE("Subtraction") {
     REQUIRE(parseTree->type() == "binary-operator");
     REQUIRE(parseTree->subTypes().at("name") == "-");
     REQUIRE(parseTree->children().size() == 2);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "2");
-    REQUIRE(parseTree->children().at(1)->rootToken().value == "1");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "2");
+    REQUIRE(parseTree->children().at(1)->rootToken().value() == "1");
 }
 
 TEST_CASE("Variable declaration") {
     auto input = "var a = 1;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -216,12 +232,13 @@ TEST_CASE("Variable declaration") {
     REQUIRE(parseTree->type() == "variable-declaration");
     REQUIRE(parseTree->subTypes().at("name") == "a");
     REQUIRE(parseTree->children().size() == 1);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "1");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "1");
 }
 
 TEST_CASE("Typed variable declaration") {
     auto input = "var a: Int = 1;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto parseTree = Test::parser.parse(tokens, 0);
 
@@ -233,12 +250,13 @@ TEST_CASE("Typed variable declaration") {
     REQUIRE(parseTree->subTypes().at("value-type") == "Int");
     REQUIRE(parseTree->subTypes().at("name") == "a");
     REQUIRE(parseTree->children().size() == 1);
-    REQUIRE(parseTree->children().at(0)->rootToken().value == "1");
+    REQUIRE(parseTree->children().at(0)->rootToken().value() == "1");
 }
 
 TEST_CASE("Module with function") {
     auto input = "fun test(x, y) {\nprint_int(x); return y;}\nprint_int(1, 2);";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto moduleExpression = Test::parser.parse(tokens, 0);
     REQUIRE(moduleExpression->type() == "module");
@@ -253,7 +271,7 @@ TEST_CASE("Module with function") {
     REQUIRE(function->children().at(1)->type() == "function-definition");
     REQUIRE(function->children().at(1)->children().at(0)->type() == "function-call");
     REQUIRE(function->children().at(1)->children().at(1)->type() == "return");
-    REQUIRE(function->children().at(1)->children().at(1)->children().at(0)->rootToken().value == "y");
+    REQUIRE(function->children().at(1)->children().at(1)->children().at(0)->rootToken().value() == "y");
 
     auto mainFunction = moduleExpression->children().at(1);
     
@@ -263,7 +281,8 @@ TEST_CASE("Module with function") {
 
 TEST_CASE("Function with types") {
     auto input = "fun test(x: Int, y: Int): Int {\nprint_int(x); return y;}";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
 
     auto moduleExpression = Test::parser.parse(tokens, 0);
     REQUIRE(moduleExpression->type() == "module");
@@ -280,5 +299,408 @@ TEST_CASE("Function with types") {
     REQUIRE(function->children().at(1)->type() == "function-definition");
     REQUIRE(function->children().at(1)->children().at(0)->type() == "function-call");
     REQUIRE(function->children().at(1)->children().at(1)->type() == "return");
-    REQUIRE(function->children().at(1)->children().at(1)->children().at(0)->rootToken().value == "y");
-}
\ No newline at end of file
+    REQUIRE(function->children().at(1)->children().at(1)->children().at(0)->rootToken().value() == "y");
+}
+namespace Test {
+    void requireSameTree(Expression* expected, Expression* actual) {
+        REQUIRE(actual->type() == expected->type());
+        REQUIRE(actual->startPos() == expected->startPos());
+        REQUIRE(actual->endPos() == expected->endPos());
+        REQUIRE(actual->subTypes() == expected->subTypes());
+        REQUIRE(actual->tokens().size() == expected->tokens().size());
+        for (int i = 0; i < (int) expected->tokens().size(); i++) {
+            REQUIRE(actual->tokens().at(i).startPos() == expected->tokens().at(i).startPos());
+            REQUIRE(actual->tokens().at(i).value() == expected->tokens().at(i).value());
+        }
+        REQUIRE(actual->children().size() == expected->children().size());
+        for (int i = 0; i < (int) expected->children().size(); i++) {
+            requireSameTree(expected->children().at(i), actual->children().at(i));
+        }
+    }
+}
+
+TEST_CASE("Streamed module gives the same tree as parsing all tokens") {
+    auto inputs = std::vector<std::string>{
+        "",
+        "a and b or c;",
+        "fun f(x: Int): Int { return x; }\nfun g(): Unit { while true do { break; }; }\nprint_int(f(1));",
+        "var x: Int = 1;; { x = (x + 2); x };\nif x > 1 then { x } else { 2 }\nfun h(): Unit {}",
+        "fun f(): Int { return 1; } f();"
+    };
+    for (auto& input : inputs) {
+        auto source = Text::Source{input};
+        auto tokens = Test::tokenizer.tokenizer.tokenize(source);
+        auto expected = Test::parser.parse(tokens, 0);
+
+        auto stream = Tokenization::TokenStream{Test::tokenizer.tokenizer, source};
+        auto sequence = TokenSequence{stream};
+        auto actual = Test::parser.parse(sequence);
+
+        Test::requireSameTree(expected, actual);
+        // Only the last statement's final token and the end token are left in the window.
+        REQUIRE(sequence.tokens().size() <= 2);
+    }
+}
+
+TEST_CASE("Streamed module ends statements without separators where the full parse does") {
+    auto functions = std::string{};
+    auto blocks = std::string{};
+    for (int i = 0; i < 100; i++) {
+        functions += "fun f" + std::to_string(i) + "(n: Int): Int { while n > 0 do { n = n - 1; }; return { n } * 2; }\n";
+        blocks += "{ a; b }\n";
+    }
+    auto inputs = std::vector<std::string>{
+        functions + "f0(1);",
+        "var t: Int = 0;\nif t > 1 then { t } else { 2 }\nfun h(): Unit {}\n{ t } * 2;\nfun k(): Int { return 1; }",
+        blocks + "fun g(): Unit {}\n" + blocks + "c;"
+    };
+    for (auto& input : inputs) {
+        auto source = Text::Source{input};
+        auto tokens = Test::tokenizer.tokenizer.tokenize(source);
+        auto expected = Test::parser.parse(tokens, 0);
+
+        auto session = Parsing::ParseSession{};
+        auto scope = Parsing::ParseSession::Scope{session};
+        auto stream = Tokenization::TokenStream{Test::tokenizer.tokenizer, source};
+        auto sequence = TokenSequence{stream};
+        auto actual = Test::parser.parse(sequence);
+
+        Test::requireSameTree(expected, actual);
+        REQUIRE(sequence.tokens().size() <= 2);
+        REQUIRE(session.offset() == 0);
+    }
+}
+
+TEST_CASE("Streamed module reports the same errors as parsing all tokens") {
+    auto source = Text::Source{"a = 1; b c; d;"};
+    auto tokens = Test::tokenizer.tokenizer.tokenize(source);
+    auto stream = Tokenization::TokenStream{Test::tokenizer.tokenizer, source};
+    auto sequence = TokenSequence{stream};
+
+    std::string expected;
+    try {
+        Test::parser.parse(tokens, 0);
+    } catch (std::runtime_error& error) {
+        expected = error.what();
+    }
+    REQUIRE(expected != "");
+    REQUIRE_THROWS_WITH(Test::parser.parse(sequence), expected.c_str());
+}
+
+TEST_CASE("Failed parses are returned as results instead of thrown") {
+    auto tokenized = Test::tokenizer.tokenizer.tokenize("fun f(x: Int): Int { while x do { x = ; }; return x; }");
+    auto& tokens = tokenized.tokens;
+
+    auto result = Parsing::ParseResult::failure(0, -1);
+    REQUIRE_NOTHROW(result = Test::parser.tryParse(tokens, 0));
+    REQUIRE(!result.succeeded());
+    REQUIRE(result.expression() == nullptr);
+    REQUIRE_THROWS_WITH(Test::parser.parse(tokens, 0), result.message(tokens).c_str());
+
+    // A mismatch that only ends a chain is not a failure.
+    tokenized = Test::tokenizer.tokenizer.tokenize("a = 1; { b; c }; d;");
+    result = Test::parser.tryParse(tokens, 0);
+    REQUIRE(result.succeeded());
+    REQUIRE(result.expression()->children().size() == 1);
+    REQUIRE(result.expression()->children().at(0)->children().at(1)->children().size() == 3);
+}
+
+TEST_CASE("Memoized parses give the same tree as unmemoized ones") {
+    auto source = std::string{"fun f(x: Int): Int { while x > 0 do { if x then { x = x - 1; } else -x; }; return x; }"};
+    auto nested = std::string{"a"};
+    for (int depth = 0; depth < 6; depth++) {
+        nested = "{ var x = (" + nested + " + a); x } * b";
+    }
+    for (auto& text : {source, nested + ";"}) {
+        auto tokenized = Test::tokenizer.tokenizer.tokenize(text);
+        auto& tokens = tokenized.tokens;
+        auto unmemoized = Parsing::ParseSession{false};
+        auto scope = Parsing::ParseSession::Scope{unmemoized};
+        auto expected = Test::parser.parse(tokens, 0);
+        auto memoized = Parsing::ParseSession{};
+        auto innerScope = Parsing::ParseSession::Scope{memoized};
+        auto actual = Test::parser.parse(tokens, 0);
+
+        Test::requireSameTree(expected, actual);
+        REQUIRE(memoized.memoEntries() > 0);
+        REQUIRE(unmemoized.memoEntries() == 0);
+    }
+}
+
+TEST_CASE("Memoized results are stored on the first attempt and shared without copying") {
+    auto text = std::string{"fun f(x: Int, g: (Int) => Int*): Int { var y: Int = g(x, 1); return y; }; f(1, 2);"};
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(text);
+    auto& tokens = tokenized.tokens;
+    auto session = Parsing::ParseSession{};
+    auto scope = Parsing::ParseSession::Scope{session};
+    auto first = Test::parser.parse(tokens, 0);
+    auto entries = session.memoEntries();
+    auto hits = session.hits();
+    REQUIRE(entries > 0);
+
+    // Trying again hands out the very tree stored the first time.
+    auto second = Test::parser.parse(tokens, 0);
+    REQUIRE(session.hits() == hits + 1);
+    REQUIRE(session.memoEntries() == entries);
+    REQUIRE(second == first);
+
+    // The parsers that rework the shared results of their sub-parsers leave those results as they were.
+    auto unmemoized = Parsing::ParseSession{false};
+    auto innerScope = Parsing::ParseSession::Scope{unmemoized};
+    Test::requireSameTree(Test::parser.parse(tokens, 0), first);
+}
+
+TEST_CASE("Long operator chains are parsed in a single pass") {
+    // a + b * c + b * c + ... with 100000 operands.
+    const int operations = 49999;
+    auto text = std::string{"a"};
+    for (int i = 0; i < operations; i++) {
+        text += " + b * c";
+    }
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(text + ";");
+    auto& tokens = tokenized.tokens;
+    auto module = Test::parser.parse(tokens, 0);
+    auto expression = module->children().at(0)->children().at(1)->children().at(0);
+
+    // The additions associate to the left and the multiplications bind tighter.
+    for (int i = operations - 1; i >= 0; i--) {
+        REQUIRE(expression->subTypes().at("name") == "+");
+        REQUIRE(expression->startPos() == 0);
+        REQUIRE(expression->endPos() == 4 * i + 5);
+        auto multiplication = expression->children().at(1);
+        REQUIRE(multiplication->subTypes().at("name") == "*");
+        REQUIRE(multiplication->children().at(0)->rootToken().value() == "b");
+        REQUIRE(multiplication->children().at(1)->rootToken().value() == "c");
+        expression = expression->children().at(0);
+    }
+    REQUIRE(expression->rootToken().value() == "a");
+}
+
+TEST_CASE("Grammar analysis decides by the next token whether parsers can start") {
+    // expression := identifier | number | "(" expression ")", and chains of expressions separated by ";".
+    auto identifier = LiteralParser{"identifier"};
+    auto number = LiteralParser{"number"};
+    auto expression = MapParser{};
+    auto parenthetical = Parsing::ParentheticalParser{"parenthetical", "(", ")", expression};
+    auto literal = Parsing::ConflictParser{{&number, &parenthetical}};
+    expression.setParsers({{"identifier", &identifier}});
+    expression.setWildCardParser(&literal);
+    auto chain = Parsing::ChainParser{"chain", ";", expression, [](std::vector<DToken>& tokens, int position) {
+        return false;
+    }};
+    auto tokenized = Test::tokenizer.tokenizer.tokenize("x; (1); )");
+    auto& tokens = tokenized.tokens;
+
+    // Without an analysis, whether a parser can start is found out by parsing.
+    REQUIRE(expression.canParseAt(tokens, 0));
+    REQUIRE(!expression.canParseAt(tokens, 1));
+    REQUIRE(!parenthetical.canParseAt(tokens, 6));
+
+    Parsing::GrammarAnalysis::analyze(chain);
+
+    REQUIRE(expression.canParseAt(tokens, 0));
+    REQUIRE(!expression.canParseAt(tokens, 1));
+    REQUIRE(expression.canParseAt(tokens, 2));
+    REQUIRE(expression.canParseAt(tokens, 3));
+    REQUIRE(!expression.canParseAt(tokens, 6));
+    REQUIRE(!identifier.canParseAt(tokens, 3));
+    REQUIRE(literal.canParseAt(tokens, 3));
+    REQUIRE(!literal.canParseAt(tokens, 0));
+    // A chain may be empty, so it can start anywhere.
+    REQUIRE(chain.canParseAt(tokens, 6));
+
+    auto result = chain.tryParse(tokens, 0);
+    REQUIRE(result.succeeded());
+    REQUIRE(result.expression()->children().size() == 2);
+    REQUIRE(result.expression()->endPos() == 6);
+}
+
+TEST_CASE("Skeleton patterns skip optional sections and trails that do not match") {
+    auto number = LiteralParser{"number"};
+    auto skeleton = Parsing::SkeletonParser{
+        "skeleton",
+        {
+            {"token-value", "return"},
+            {"optional", ""},
+            {"token-value", ":"},
+            {"token-type", "identifier"},
+            {"/optional", ""},
+            {"expression", "N"},
+            {"trail", ""},
+            {"token-value", "else"},
+            {"expression", "N"}
+        },
+        {{"N", &number}}
+    };
+
+    auto tokenized = Test::tokenizer.tokenizer.tokenize("return : x 1 else 2");
+    auto& tokens = tokenized.tokens;
+    auto result = skeleton.tryParse(tokens, 0);
+    REQUIRE(result.succeeded());
+    REQUIRE(result.expression()->endPos() == 6);
+    REQUIRE(result.expression()->children().size() == 3);
+    REQUIRE(result.expression()->children().at(0)->type() == "identifier");
+    REQUIRE(result.expression()->tokens().size() == 4);
+
+    tokenized = Test::tokenizer.tokenizer.tokenize("return 1 ;");
+    result = skeleton.tryParse(tokens, 0);
+    REQUIRE(result.succeeded());
+    REQUIRE(result.expression()->endPos() == 2);
+    REQUIRE(result.expression()->children().size() == 1);
+
+    // An optional section that starts matching skips to its end at the first mismatch.
+    tokenized = Test::tokenizer.tokenizer.tokenize("return : 1 else 2");
+    result = skeleton.tryParse(tokens, 0);
+    REQUIRE(result.succeeded());
+    REQUIRE(result.expression()->endPos() == 5);
+
+    tokenized = Test::tokenizer.tokenizer.tokenize("return x");
+    result = skeleton.tryParse(tokens, 0);
+    REQUIRE(!result.succeeded());
+    REQUIRE(result.position() == 1);
+}
+
+TEST_CASE("Parsed trees live in the arena of the scope") {
+    auto arena = Parsing::ExpressionArena{};
+    auto tokenized = Test::tokenizer.tokenizer.tokenize("var x = 1 + 2; print_int(x);");
+    auto& tokens = tokenized.tokens;
+    Expression* module = nullptr;
+    {
+        auto scope = Parsing::ExpressionArena::Scope{arena};
+        module = Test::parser.parse(tokens, 0);
+    }
+    REQUIRE(arena.size() >= (std::size_t) Expression::size(module));
+    REQUIRE(arena.bytes() > 0);
+    REQUIRE(module->children().at(0)->parent() == module);
+
+    // Children added one at a time keep their order as their list grows.
+    auto parent = Expression::create("list", 0, 0);
+    for (int i = 0; i < 100; i++) {
+        Expression::addChild(parent, Expression::create("item", i, i + 1));
+    }
+    REQUIRE(parent->children().size() == 100);
+    REQUIRE(parent->endPos() == 100);
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(parent->children().at(i)->startPos() == i);
+        REQUIRE(parent->children().at(i)->parent() == parent);
+    }
+    Expression::removeChild(parent, parent->children().at(0));
+    REQUIRE(parent->children().size() == 99);
+    REQUIRE(parent->children().front()->startPos() == 1);
+
+    // A list longer than the first blocks of a new arena still gets all the room it needs.
+    auto largeArena = Parsing::ExpressionArena{};
+    auto largeScope = Parsing::ExpressionArena::Scope{largeArena};
+    auto items = std::vector<Expression*>{};
+    for (int i = 0; i < 3000; i++) {
+        items.push_back(Expression::create("item", i, i + 1));
+    }
+    auto list = Expression::create("list", 0, 0);
+    list->setChildren(items);
+    auto other = Expression::create("list", 0, 0);
+    other->setChildren({items.front()});
+    REQUIRE(list->children().size() == 3000);
+    REQUIRE(list->children().back() == items.back());
+    REQUIRE(other->children().front() == items.front());
+}
+
+TEST_CASE("Attributes are registered by the language and literal values stay in the arena") {
+    auto tokenized = Test::tokenizer.tokenizer.tokenize("var x: Int = 1234567;");
+    auto& tokens = tokenized.tokens;
+    auto module = Test::parser.parse(tokens, 0);
+    auto declaration = module->children().at(0)->children().at(1)->children().at(0);
+    auto number = declaration->children().at(0);
+    REQUIRE(declaration->subTypes().at("value-type") == "Int");
+    REQUIRE(number->subTypes().at("value") == "1234567");
+    REQUIRE(!number->subTypes().contains("name"));
+
+    // Registering an attribute again gives the same key, and its values are only interned if they are names or types.
+    auto valueKey = Expression::registerAttribute("value", Expression::EAttributeSlot::value);
+    auto typeKey = Expression::registerAttribute("value-type", Expression::EAttributeSlot::type);
+    REQUIRE(Expression::registerAttribute("value", Expression::EAttributeSlot::value) == valueKey);
+    REQUIRE(number->attributeId(valueKey) == Parsing::Names::none);
+    REQUIRE(declaration->attributeId(typeKey) == declaration->typeId());
+    REQUIRE(Parsing::Names::name(declaration->attributeId(typeKey)) == "Int");
+    REQUIRE_THROWS(Expression::registerAttribute("value", Expression::EAttributeSlot::name));
+    REQUIRE_THROWS(number->subTypes().insert({"unregistered", "1"}));
+
+    // Values compare by their text, wherever they are kept.
+    auto copy = Expression::clone(number);
+    REQUIRE(copy->subTypes() == number->subTypes());
+    REQUIRE(&copy->subTypes().at("value") != &number->subTypes().at("value"));
+}
+
+TEST_CASE("Spans are kept up to date as wide and deep trees are built") {
+    // a + a + ... with 100000 operands nests the additions 100000 deep to the left.
+    const int operations = 99999;
+    auto text = std::string{"a"};
+    for (int i = 0; i < operations; i++) {
+        text += " + a";
+    }
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(text + ";");
+    auto& tokens = tokenized.tokens;
+    auto module = Test::parser.parse(tokens, 0);
+    auto expression = module->children().at(0)->children().at(1)->children().at(0);
+    for (int i = operations - 1; i >= 0; i--) {
+        REQUIRE(expression->startLocation().positionIndex() == 0);
+        REQUIRE(expression->endLocation().positionIndex() == 4 * i + 5);
+        expression = expression->children().at(0);
+    }
+
+    // Adding children to the last of many children updates the ends of both.
+    auto source = Text::Source{std::string(200000, 'x')};
+    auto token = [&source](int position) {
+        return DToken{0, -1, (std::uint32_t) position, 1, &source};
+    };
+    auto root = Expression::create("root", 0, 0);
+    for (int i = 0; i < 100000; i++) {
+        auto child = Expression::create("child", i, i + 1);
+        Expression::addToken(child, token(i));
+        Expression::addChild(root, child);
+    }
+    auto last = root->children().back();
+    for (int i = 100000; i < 200000; i++) {
+        auto grandchild = Expression::create("grandchild", i, i + 1);
+        Expression::addToken(grandchild, token(i));
+        Expression::addChild(last, grandchild);
+    }
+    REQUIRE(root->endPos() == 200000);
+    REQUIRE(root->startLocation().positionIndex() == 0);
+    REQUIRE(root->endLocation().positionIndex() == 200000);
+    Expression::removeChild(root, last);
+    REQUIRE(root->endLocation().positionIndex() == 99999);
+}
+
+TEST_CASE("Function definitions parsed on several threads give the same tree as a serial parse") {
+    auto module = std::string{"var total: Int = 0;\n"};
+    for (int i = 0; i < 40; i++) {
+        auto name = "f" + std::to_string(i);
+        module += "fun " + name + "(x: Int): Int { while x > 0 do { if x == 3 then { break; }; x = x - 1; }; return x * " + name + "(x); }\n";
+        if (i % 7 == 0) {
+            module += "total = total + " + name + "(" + std::to_string(i) + ");;\n";
+        }
+    }
+    module += "{ fun_like(1); } print_int(total);";
+    auto parallelParser = MyLanguage::Parser{};
+    parallelParser.setThreads(4);
+
+    auto source = Text::Source{module};
+    auto tokens = Test::tokenizer.tokenizer.tokenize(source);
+    auto expected = Test::parser.parse(tokens, 0);
+    auto actual = parallelParser.parse(tokens, 0);
+    Test::requireSameTree(expected, actual);
+    REQUIRE(actual->children().size() == 41);
+    REQUIRE(actual->children().at(40)->subTypes().at("name") == "main");
+
+    // A definition that fails to parse is reported just like in a serial parse.
+    auto broken = Text::Source{module + "\nfun g(): Unit { break; }\nfun h(): Unit { x = ; }"};
+    tokens = Test::tokenizer.tokenizer.tokenize(broken);
+    std::string error;
+    try {
+        Test::parser.parse(tokens, 0);
+    } catch (std::runtime_error& exception) {
+        error = exception.what();
+    }
+    REQUIRE(error != "");
+    REQUIRE_THROWS_WITH(parallelParser.parse(tokens, 0), error.c_str());
+}
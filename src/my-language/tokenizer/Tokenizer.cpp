@@ -1,32 +1,62 @@
 #include "Tokenizer.h"
 
+namespace {
+    // The token patterns of our language. Operators are listed one by one so 
+    // that each of them is a literal and their tokens carry its symbol.
+    constexpr auto tokens = std::to_array<Tokenization::TokenRule>({
+        {"whitespace", "\\s+"},
+        {"comment", "(//|#).*\n"},
+        {"number", "[0-9]+"},
+        {"fat-right-arrow", "=>"},
+        {"binary-operator", "\\=\\="},
+        {"binary-operator", "\\!\\="},
+        {"binary-operator", "\\<\\="},
+        {"binary-operator", "\\>\\="},
+        {"binary-operator", "\\+"},
+        {"binary-operator", "\\/"},
+        {"binary-operator", "\\="},
+        {"binary-operator", "\\<"},
+        {"binary-operator", "\\>"},
+        {"binary-operator", "%"},
+        {"asterisk", "\\*"},
+        {"ampersand", "\\&"},
+        {"minus", "-"},
+        {"parentheses", "\\("},
+        {"parentheses", "\\)"},
+        {"parentheses", "[{]"},
+        {"parentheses", "[}]"},
+        {"colon", ":"},
+        {"statement-separator", ";"},
+        {"statement-separator", ","},
+        {"identifier", "[A-Za-z_][A-Za-z0-9_-]*"}
+    });
+
+    // Words that are lexed as identifiers but have token kinds of their own.
+    constexpr auto keywords = Tokenization::KeywordTable{std::to_array<Tokenization::Keyword>({
+        {"fun", "function-keyword"},
+        {"return", "return"},
+        {"if", "if"},
+        {"then", "then"},
+        {"else", "else"},
+        {"while", "while"},
+        {"do", "do"},
+        {"break", "break"},
+        {"continue", "continue"},
+        {"var", "var"},
+        {"true", "boolean"},
+        {"false", "boolean"},
+        {"and", "binary-operator"},
+        {"or", "binary-operator"},
+        {"not", "unary-operator"},
+        {"new", "unary-operator"},
+        {"delete", "unary-operator"}
+    })};
+}
+
 Tokenizer::Tokenizer(Tokenization::Tokenizer tokenizer):
     tokenizer(tokenizer)
 {
-    // Configure the different token patterns of our language.
-    this->tokenizer.addRegexPattern("whitespace", "\\s+");
-    this->tokenizer.addRegexPattern("comment", "(//|#).*\n");
-    this->tokenizer.addRegexPattern("number", "[0-9]+");
-    this->tokenizer.addRegexPattern("fat-right-arrow", "=>");
-    this->tokenizer.addRegexPattern("function-keyword", "fun");
-    this->tokenizer.addRegexPattern("return", "return");
-    this->tokenizer.addRegexPattern("if", "if");
-    this->tokenizer.addRegexPattern("then", "then");
-    this->tokenizer.addRegexPattern("else", "else");
-    this->tokenizer.addRegexPattern("while", "while");
-    this->tokenizer.addRegexPattern("do", "do");
-    this->tokenizer.addRegexPattern("break", "break");
-    this->tokenizer.addRegexPattern("continue", "continue");
-    this->tokenizer.addRegexPattern("boolean", "(true|false)");
-    this->tokenizer.addRegexPattern("binary-operator", "(\\=\\=|\\!\\=|\\<\\=|\\>\\=)");
-    this->tokenizer.addRegexPattern("binary-operator", "(\\+|\\/|\\=|\\<|\\>|%|and|or)");
-    this->tokenizer.addRegexPattern("asterisk", "\\*");
-    this->tokenizer.addRegexPattern("ampersand", "\\&");
-    this->tokenizer.addRegexPattern("minus", "-");
-    this->tokenizer.addRegexPattern("unary-operator", "(not|new|delete)");
-    this->tokenizer.addRegexPattern("parentheses", "[(){}]");
-    this->tokenizer.addRegexPattern("colon", ":");
-    this->tokenizer.addRegexPattern("statement-separator", ";");
-    this->tokenizer.addRegexPattern("statement-separator", ",");
-    this->tokenizer.addRegexPattern("identifier", "[A-Za-z_][A-Za-z0-9_-]*");
-}
\ No newline at end of file
+    this->tokenizer.addSpecification<tokens>();
+    // Keywords are looked up from the identifiers.
+    this->tokenizer.addKeywords("identifier", keywords);
+}
@@ -0,0 +1,197 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../Tokenizer.h"
+#include "../../../components/text/ByteScanner.h"
+
+/**
+ * Measures the throughput of tokenizing synthetic source code of growing size,
+ * from a kilobyte up to the largest size, for several mixes of tokens. The results
+ * are printed as JSON: the speed in megabytes and tokens per second and the peak
+ * resident memory of each run, and per mix of tokens the exponent of a power law
+ * fitted to the time taken. An exponent close to 1 means tokenizing is linear.
+ *
+ * Each run happens in a process of its own, so that its peak memory is not
+ * hidden by the runs before it. Small inputs are tokenized repeatedly until
+ * enough time has passed to measure.
+ *
+ * Usage: Tokenizer.benchmark.out [largest size in megabytes]
+ */
+
+// A snippet of typical source code.
+const std::string codeSnippet =
+    "# Computes the n:th fibonacci number.\n"
+    "fun fibonacci(n: Int): Int {\n"
+    "    var previous: Int = 0;\n"
+    "    var current: Int = 1;\n"
+    "    while n > 0 do {\n"
+    "        var next: Int = previous + current;\n"
+    "        previous = current;\n"
+    "        current = next;\n"
+    "        n = n - 1;\n"
+    "    }\n"
+    "    return previous;\n"
+    "}\n"
+    "// Pointers and booleans.\n"
+    "var p: Int* = new Int(42);\n"
+    "if not (*p == 42) or false then print_int(*p) else print_int(fibonacci(10 % 7));\n"
+    "delete p;\n";
+
+// A snippet of code that is mostly long comments, indentation and long names.
+const std::string commentSnippet =
+    "// ----------------------------------------------------------------------------\n"
+    "// Updates the running total of the accumulated values. The total is kept in a\n"
+    "// variable of its own so that it can be printed at the end of the program.\n"
+    "// ----------------------------------------------------------------------------\n"
+    "                                                                                \n"
+    "                accumulated_running_total-value = accumulated_running_total-value;\n";
+
+// A snippet of code made mostly of names, with few operators and no comments.
+const std::string identifierSnippet =
+    "var customer_account_balance: Int = opening_balance;\n"
+    "customer_account_balance = apply_interest(customer_account_balance, yearly_rate);\n"
+    "record_transaction(ledger, customer_account_balance, transaction_date, teller);\n"
+    "notify_customer(customer_account_balance, preferred_contact-method);\n";
+
+// A snippet of code where almost every other token is a short operator.
+const std::string operatorSnippet =
+    "x=a+b*c-d/e%f;y=a==b!=c<=d>=e<f>g;z=(a+(b-(c*(d/e))))%&f;\n"
+    "w=*p+*q-&r*s/t;v=not a and b or c==1;u=-1+-2*-3;t=a=>b;\n";
+
+// Returns a function whose body nests blocks to the given depth.
+std::string createNestedSnippet(int depth) {
+    auto snippet = std::string{"fun nested(x: Int): Int {\n"};
+    for (int i = 0; i < depth; i++) {
+        snippet += std::string(4 * (i + 1), ' ') + "if x > " + std::to_string(i) + " then {\n";
+    }
+    snippet += std::string(4 * (depth + 1), ' ') + "x = x - 1;\n";
+    for (int i = depth - 1; i >= 0; i--) {
+        snippet += std::string(4 * (i + 1), ' ') + "} else { x = x + 1; };\n";
+    }
+    return snippet + "    return x;\n}\n";
+}
+
+std::string createInput(const std::string& snippet, size_t size) {
+    std::string input;
+    input.reserve(size + snippet.size());
+    while (input.size() < size) {
+        input += snippet;
+    }
+    return input;
+}
+
+// The result of tokenizing one input.
+struct DRun {
+    double bytes;
+    double tokens;
+    double seconds;
+    double peakMegabytes;
+};
+
+// The least amount of time to spend tokenizing each input.
+const double minimumSeconds = 0.2;
+
+DRun measure(Tokenizer& tokenizer, const std::string& snippet, size_t size) {
+    auto input = Text::Source{createInput(snippet, size)};
+    auto run = DRun{(double) input.text().size(), 0, 0, 0};
+    int repetitions = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        run.tokens = (double) tokenizer.tokenizer.tokenize(input).size();
+        repetitions++;
+        run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (run.seconds < minimumSeconds);
+    run.seconds = run.seconds / repetitions;
+    auto usage = rusage{};
+    getrusage(RUSAGE_SELF, &usage);
+    run.peakMegabytes = usage.ru_maxrss / 1024.0;
+    return run;
+}
+
+// Measures in a child process and passes the result back through a pipe.
+DRun measureInChild(Tokenizer& tokenizer, const std::string& snippet, size_t size) {
+    int channel[2];
+    if (pipe(channel) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    std::cout.flush();
+    pid_t child = fork();
+    if (child == 0) {
+        close(channel[0]);
+        auto run = measure(tokenizer, snippet, size);
+        bool written = write(channel[1], &run, sizeof(run)) == sizeof(run);
+        _exit(written ? 0 : 1);
+    }
+    close(channel[1]);
+    auto run = DRun{};
+    bool received = read(channel[0], &run, sizeof(run)) == sizeof(run);
+    close(channel[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!received || status != 0) {
+        std::cerr << "Benchmark run failed." << std::endl;
+        std::exit(1);
+    }
+    return run;
+}
+
+// The slope of the least squares line through the points (log bytes, log seconds).
+double growthExponent(const std::vector<DRun>& runs) {
+    double n = runs.size(), sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    for (auto& run : runs) {
+        double x = std::log(run.bytes), y = std::log(run.seconds);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+    }
+    return (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+}
+
+int main(int argc, char* argv[]) {
+    double largestMegabytes = argc > 1 ? std::atof(argv[1]) : 100;
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    // Sizes grow fourfold from one kilobyte, ending with the largest size.
+    auto sizes = std::vector<double>{};
+    for (double megabytes = 1.0 / 1024; megabytes < largestMegabytes; megabytes *= 4) {
+        sizes.push_back(megabytes);
+    }
+    sizes.push_back(largestMegabytes);
+    auto snippets = std::vector<std::pair<std::string, std::string>>{
+        {"code", codeSnippet},
+        {"comments", commentSnippet},
+        {"identifiers", identifierSnippet},
+        {"operators", operatorSnippet},
+        {"nested", createNestedSnippet(12)}
+    };
+    std::cout << "{\n  \"kernel\": \"" << Text::ByteScanner::kernel() << "\",\n  \"families\": [";
+    for (int family = 0; family < (int) snippets.size(); family++) {
+        auto& [name, snippet] = snippets[family];
+        std::cout << (family == 0 ? "\n" : ",\n") << "    {\"name\": \"" << name << "\", \"runs\": [";
+        auto runs = std::vector<DRun>{};
+        for (double megabytes : sizes) {
+            auto run = measureInChild(tokenizer, snippet, (size_t) (megabytes * 1024 * 1024));
+            runs.push_back(run);
+            double actualMegabytes = run.bytes / (1024.0 * 1024.0);
+            std::cout
+                << (runs.size() == 1 ? "\n" : ",\n")
+                << "      {\"bytes\": " << (long long) run.bytes
+                << ", \"tokens\": " << (long long) run.tokens
+                << ", \"seconds\": " << run.seconds
+                << ", \"megabytesPerSecond\": " << actualMegabytes / run.seconds
+                << ", \"tokensPerSecond\": " << run.tokens / run.seconds
+                << ", \"peakRssMegabytes\": " << run.peakMegabytes << "}";
+        }
+        std::cout << "\n    ], \"growthExponent\": " << growthExponent(runs) << "}";
+    }
+    std::cout << "\n  ]\n}" << std::endl;
+    return 0;
+}
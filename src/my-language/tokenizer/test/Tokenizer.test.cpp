@@ -3,49 +3,354 @@
 #include "../../../libraries/catch.h"
 #include "../Tokenizer.h"
 #include "../../../components/tokenization/Tokenization.h"
+#include "../../../components/tokenization/TokenStream.h"
+#include "../../../components/text/ByteScanner.h"
+#include <cctype>
+#include <cstdio>
+#include <fstream>
 
 TEST_CASE( "parentheses are recognized", "[tokenize]" ) {
     auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
-    auto tokens = tokenizer.tokenizer.tokenize("//\n () ");
+    auto tokenized = tokenizer.tokenizer.tokenize("//\n () ");
+    auto& tokens = tokenized.tokens;
     
     REQUIRE(tokens.size() == 3);
 
-    REQUIRE(tokens.at(0).type == "parentheses");
-    REQUIRE(tokens.at(0).value == "(");
-    REQUIRE(tokens.at(0).startPos == 4);
-    REQUIRE(tokens.at(0).endPos == 5);
+    REQUIRE(tokens.at(0).type() == "parentheses");
+    REQUIRE(tokens.at(0).value() == "(");
+    REQUIRE(tokens.at(0).startPos() == 4);
+    REQUIRE(tokens.at(0).endPos() == 5);
 
-    REQUIRE(tokens.at(1).type == "parentheses");
-    REQUIRE(tokens.at(1).value == ")");
-    REQUIRE(tokens.at(1).startPos == 5);
-    REQUIRE(tokens.at(1).endPos == 6);
+    REQUIRE(tokens.at(1).type() == "parentheses");
+    REQUIRE(tokens.at(1).value() == ")");
+    REQUIRE(tokens.at(1).startPos() == 5);
+    REQUIRE(tokens.at(1).endPos() == 6);
 
-    REQUIRE(tokens.at(2).type == "end");
-    REQUIRE(tokens.at(2).value == "");
-    REQUIRE(tokens.at(2).startPos == 7);
-    REQUIRE(tokens.at(2).endPos == 7);
+    REQUIRE(tokens.at(2).type() == "end");
+    REQUIRE(tokens.at(2).value() == "");
+    REQUIRE(tokens.at(2).startPos() == 7);
+    REQUIRE(tokens.at(2).endPos() == 7);
 }
 
 TEST_CASE("identifier names can contain everything they should", "[tokenize]") {
     auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
-    auto tokens = tokenizer.tokenizer.tokenize("//\n _aBzY3D- ");
+    auto tokenized = tokenizer.tokenizer.tokenize("//\n _aBzY3D- ");
+    auto& tokens = tokenized.tokens;
     
     REQUIRE(tokens.size() == 2);
 
-    REQUIRE(tokens.at(0).type == "identifier");
-    REQUIRE(tokens.at(0).value == "_aBzY3D-");
-    REQUIRE(tokens.at(0).startPos == 4);
-    REQUIRE(tokens.at(0).endPos == 12);
+    REQUIRE(tokens.at(0).type() == "identifier");
+    REQUIRE(tokens.at(0).value() == "_aBzY3D-");
+    REQUIRE(tokens.at(0).startPos() == 4);
+    REQUIRE(tokens.at(0).endPos() == 12);
 }
 
 TEST_CASE("keywords are prioritized over identifiers", "[tokenize]") {
     auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
-    auto tokens = tokenizer.tokenizer.tokenize("//\n if ");
+    auto tokenized = tokenizer.tokenizer.tokenize("//\n if ");
+    auto& tokens = tokenized.tokens;
     
     REQUIRE(tokens.size() == 2);
 
-    REQUIRE(tokens.at(0).type == "if");
-    REQUIRE(tokens.at(0).value == "if");
-    REQUIRE(tokens.at(0).startPos == 4);
-    REQUIRE(tokens.at(0).endPos == 6);
-}
\ No newline at end of file
+    REQUIRE(tokens.at(0).type() == "if");
+    REQUIRE(tokens.at(0).value() == "if");
+    REQUIRE(tokens.at(0).startPos() == 4);
+    REQUIRE(tokens.at(0).endPos() == 6);
+}
+
+TEST_CASE("the longest match wins over an earlier pattern", "[tokenize]") {
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto tokenized = tokenizer.tokenizer.tokenize("iffy funny == =>");
+    auto& tokens = tokenized.tokens;
+    
+    REQUIRE(tokens.size() == 5);
+
+    REQUIRE(tokens.at(0).type() == "identifier");
+    REQUIRE(tokens.at(0).value() == "iffy");
+    REQUIRE(tokens.at(1).type() == "identifier");
+    REQUIRE(tokens.at(1).value() == "funny");
+    REQUIRE(tokens.at(2).type() == "binary-operator");
+    REQUIRE(tokens.at(2).value() == "==");
+    REQUIRE(tokens.at(3).type() == "fat-right-arrow");
+    REQUIRE(tokens.at(3).value() == "=>");
+}
+
+TEST_CASE("token locations are the same as when counted from the start", "[tokenize]") {
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    std::string text = "# comment\nfun f(x: Int): Int {\n\n    return x + 1;\n}\nf(2)\n";
+    auto tokenized = tokenizer.tokenizer.tokenize(text);
+    auto& tokens = tokenized.tokens;
+
+    for (auto& token : tokens) {
+        auto start = Text::Location{token.startPos(), text.begin()};
+        auto end = Text::Location{token.endPos(), text.begin()};
+        REQUIRE(token.startLocation().toString() == start.toString());
+        REQUIRE(token.endLocation().toString() == end.toString());
+    }
+}
+
+TEST_CASE("patterns the automaton does not support still use the longest match", "[tokenize]") {
+    auto tokenizer = Tokenization::Tokenizer{};
+    tokenizer.addRegexPattern("whitespace", "\\s+");
+    tokenizer.addRegexPattern("keyword", "\\bif\\b");
+    tokenizer.addRegexPattern("identifier", "[a-z]+");
+    auto tokenized = tokenizer.tokenize("if iffy");
+    auto& tokens = tokenized.tokens;
+
+    REQUIRE(tokens.size() == 3);
+
+    REQUIRE(tokens.at(0).type() == "keyword");
+    REQUIRE(tokens.at(1).type() == "identifier");
+    REQUIRE(tokens.at(1).value() == "iffy");
+    REQUIRE(tokens.at(1).startPos() == 3);
+}
+
+TEST_CASE("tokens refer into the source instead of copying their text", "[tokenize]") {
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto source = Text::Source{"var x: Int = 42;"};
+    auto tokens = tokenizer.tokenizer.tokenize(source);
+
+    REQUIRE(tokens.size() == 8);
+
+    REQUIRE(tokens.at(5).type() == "number");
+    REQUIRE(tokens.at(5).value() == "42");
+    REQUIRE(tokens.at(5).value().data() == source.text().data() + 13);
+    REQUIRE(tokens.at(5).source == &source);
+    REQUIRE(tokens.at(5).kind == Tokenization::Symbols::id("number"));
+    REQUIRE(tokens.at(7).kind == Tokenization::Symbols::end);
+}
+
+TEST_CASE("tokenized text owns the source its tokens refer into", "[tokenize]") {
+    auto tokenized = Tokenization::DTokenizedText{};
+    {
+        auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+        tokenized = tokenizer.tokenizer.tokenize(std::string{"var x: Int = 42;"});
+    }
+    auto copy = tokenized;
+    tokenized = Tokenization::DTokenizedText{};
+
+    REQUIRE(copy.source.use_count() == 1);
+    REQUIRE(copy.tokens.at(5).source == copy.source.get());
+    REQUIRE(copy.tokens.at(5).value() == "42");
+}
+
+TEST_CASE("source locations are looked up from the line index", "[tokenize]") {
+    for (std::string text : {std::string{""}, std::string{"abc"}, std::string{"\n\nab\r\ncd\n"}, std::string{"a\nb"}}) {
+        auto source = Text::Source{text};
+        for (int position = 0; position <= (int) text.size(); position++) {
+            auto expected = Text::Location{position, text.begin()};
+            auto location = source.location(position);
+            REQUIRE(location.line() == expected.line());
+            REQUIRE(location.column() == expected.column());
+            REQUIRE(location.positionIndex() == position);
+        }
+    }
+}
+
+TEST_CASE("tokens with a fixed spelling carry its interned symbol", "[tokenize]") {
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto tokenized = tokenizer.tokenizer.tokenize("var x = a <= b;");
+    auto& tokens = tokenized.tokens;
+
+    REQUIRE(tokens.size() == 8);
+
+    REQUIRE(tokens.at(0).type() == "var");
+    REQUIRE(tokens.at(0).symbol == Tokenization::Symbols::id("var"));
+    REQUIRE(tokens.at(1).symbol == -1);
+    REQUIRE(tokens.at(2).type() == "binary-operator");
+    REQUIRE(tokens.at(2).symbol == Tokenization::Symbols::id("="));
+    REQUIRE(tokens.at(4).symbol == Tokenization::Symbols::id("<="));
+    REQUIRE(tokens.at(6).symbol == Tokenization::Symbols::id(";"));
+}
+
+TEST_CASE("regex patterns only match at the given offset", "[tokenize]") {
+    for (std::string regex : {std::string{"[0-9]+"}, std::string{"[0-9]{1,}"}}) {
+        auto pattern = RegexPattern{regex};
+        std::string_view text = "ab 123 4";
+
+        REQUIRE(pattern.recognizeAt(text, 0) == -1);
+        REQUIRE(pattern.recognizeAt(text, 3) == 3);
+        REQUIRE(pattern.recognizeAt(text, 4) == 2);
+        REQUIRE(pattern.recognizeAt(text, 6) == -1);
+        REQUIRE(pattern.recognizeAt(text, 7) == 1);
+        REQUIRE(pattern.recognizeAt(text, 8) == -1);
+    }
+    auto startOfText = RegexPattern{"^a"};
+    REQUIRE(startOfText.recognizeAt("aa", 0) == 1);
+    REQUIRE(startOfText.recognizeAt("aa", 1) == -1);
+}
+
+TEST_CASE("mapped files are tokenized like the same text", "[tokenize]") {
+    auto text = std::string{"fun f(): Int {\n    return 42; // answer\n}\n"};
+    auto path = std::string{"_mapped_source.mylang"};
+    {
+        auto file = std::ofstream{path, std::ios::binary};
+        file << text;
+    }
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto mapped = Text::Source::map(path);
+    auto source = Text::Source{text};
+
+    REQUIRE(mapped->text() == text);
+
+    auto stream = Tokenization::TokenStream{tokenizer.tokenizer, *mapped};
+    auto tokens = tokenizer.tokenizer.tokenize(source);
+    for (auto& token : tokens) {
+        auto streamed = stream.next();
+        REQUIRE(streamed.kind == token.kind);
+        REQUIRE(streamed.value() == token.value());
+        REQUIRE(streamed.startPos() == token.startPos());
+    }
+    REQUIRE(stream.finished());
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS(Text::Source::map("_missing_source.mylang"));
+}
+
+TEST_CASE("every scanning kernel finds the same end of a run", "[tokenize]") {
+    auto whitespace = std::array<bool, 256>{};
+    auto identifier = std::array<bool, 256>{};
+    auto line = std::array<bool, 256>{};
+    for (int byte = 0; byte < 256; byte++) {
+        whitespace[byte] = std::isspace(byte);
+        identifier[byte] = std::isalnum(byte) || byte == '_' || byte == '-';
+        line[byte] = byte != '\n' && byte != '\r';
+    }
+    // Runs of every length up to a few vectors, ended by each kind of byte.
+    auto text = std::string{};
+    for (int length = 0; length < 80; length++) {
+        text += std::string(length, " a_\t-Z9x"[length % 8]) + "\n" + std::string(length % 5, '.') + (char) (200 + length % 50);
+    }
+    for (auto& set : {whitespace, identifier, line}) {
+        REQUIRE(Text::ByteScanner::supports(set));
+        auto scanner = Text::ByteScanner{set};
+        for (size_t offset = 0; offset < text.size(); offset++) {
+            const char* begin = text.data() + offset;
+            const char* end = text.data() + text.size();
+            auto expected = scanner.spanScalar(begin, end);
+            REQUIRE(scanner.span(begin, end) == expected);
+            REQUIRE(scanner.spanSse2(begin, end) == expected);
+            if (Text::ByteScanner::kernel() == "avx2") {
+                REQUIRE(scanner.spanAvx2(begin, end) == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("long runs of whitespace, comments and identifiers are single tokens", "[tokenize]") {
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto name = std::string(100, 'a') + "-_9";
+    auto text = std::string(70, ' ') + "// " + std::string(90, '=') + "\n" + std::string(33, '\t') + name + " " + std::string(40, '7');
+    auto tokenized = tokenizer.tokenizer.tokenize(text);
+    auto& tokens = tokenized.tokens;
+
+    REQUIRE(tokens.size() == 3);
+    REQUIRE(tokens.at(0).type() == "identifier");
+    REQUIRE(tokens.at(0).value() == name);
+    REQUIRE(tokens.at(1).type() == "number");
+    REQUIRE(tokens.at(1).length == 40);
+}
+
+TEST_CASE("keywords are looked up from a perfect hash table", "[tokenize]") {
+    constexpr auto keywords = Tokenization::KeywordTable{std::to_array<Tokenization::Keyword>({
+        {"if", "if"}, {"then", "then"}, {"else", "else"}, {"and", "binary-operator"}
+    })};
+    static_assert(keywords.find("else") == 2);
+    static_assert(keywords.find("elsewhere") == -1);
+    REQUIRE(keywords.find("and") == 3);
+    REQUIRE(keywords.find("") == -1);
+    REQUIRE(keywords.find("iff") == -1);
+
+    auto tokenizer = Tokenizer{Tokenization::Tokenizer{}};
+    auto tokenized = tokenizer.tokenizer.tokenize("done do true and android not-x");
+    auto& tokens = tokenized.tokens;
+
+    REQUIRE(tokens.size() == 7);
+    REQUIRE(tokens.at(0).type() == "identifier");
+    REQUIRE(tokens.at(1).type() == "do");
+    REQUIRE(tokens.at(1).symbol == Tokenization::Symbols::id("do"));
+    REQUIRE(tokens.at(2).type() == "boolean");
+    REQUIRE(tokens.at(2).symbol == Tokenization::Symbols::id("true"));
+    REQUIRE(tokens.at(3).type() == "binary-operator");
+    REQUIRE(tokens.at(3).symbol == Tokenization::Symbols::id("and"));
+    REQUIRE(tokens.at(4).type() == "identifier");
+    REQUIRE(tokens.at(4).symbol == -1);
+    REQUIRE(tokens.at(5).type() == "identifier");
+    REQUIRE(tokens.at(5).value() == "not-x");
+}
+
+namespace {
+    constexpr auto arithmetic = std::to_array<Tokenization::TokenRule>({
+        {"whitespace", "\\s+"},
+        {"number", "[0-9]+"},
+        {"operator", "\\*\\*"},
+        {"operator", "\\*"},
+        {"operator", "-"},
+        {"identifier", "[a-z]+"}
+    });
+}
+
+TEST_CASE("token specifications are compiled into an automaton while compiling", "[tokenize]") {
+    using Arithmetic = Tokenization::TokenSpecification<arithmetic>;
+    static_assert(Arithmetic::automaton.match("12**x", 0) == std::pair<int, int>{1, 2});
+    static_assert(Arithmetic::automaton.match("12**x", 2) == std::pair<int, int>{2, 2});
+    static_assert(Arithmetic::automaton.match("12*-x", 2) == std::pair<int, int>{3, 1});
+    static_assert(Arithmetic::automaton.match("+", 0) == std::pair<int, int>{-1, 0});
+    static_assert(Arithmetic::ruleOf("identifier") == 5);
+
+    auto tokenizer = Tokenization::Tokenizer{};
+    tokenizer.addSpecification<arithmetic>();
+    auto tokenized = tokenizer.tokenize("a ** 12-b");
+    auto& tokens = tokenized.tokens;
+
+    REQUIRE(tokens.size() == 6);
+    REQUIRE(tokens.at(1).type() == "operator");
+    REQUIRE(tokens.at(1).symbol == Tokenization::Symbols::id("**"));
+    REQUIRE(tokens.at(2).type() == "number");
+    REQUIRE(tokens.at(2).symbol == -1);
+    REQUIRE(tokens.at(3).symbol == Tokenization::Symbols::id("-"));
+
+    // Patterns added afterwards are still recognized, and still lose to earlier ones.
+    tokenizer.addRegexPattern("word", "[a-z]+|\\?");
+    tokenized = tokenizer.tokenize("a?");
+    REQUIRE(tokens.at(0).type() == "identifier");
+    REQUIRE(tokens.at(1).type() == "word");
+}
+
+TEST_CASE("the compiled token specification tokenizes like the same patterns added at runtime", "[tokenize]") {
+    auto runtime = Tokenization::Tokenizer{};
+    runtime.addRegexPattern("whitespace", "\\s+");
+    runtime.addRegexPattern("comment", "(//|#).*\n");
+    runtime.addRegexPattern("number", "[0-9]+");
+    runtime.addRegexPattern("fat-right-arrow", "=>");
+    runtime.addRegexPattern("binary-operator", "(\\=\\=|\\!\\=|\\<\\=|\\>\\=)");
+    runtime.addRegexPattern("binary-operator", "(\\+|\\/|\\=|\\<|\\>|%)");
+    runtime.addRegexPattern("asterisk", "\\*");
+    runtime.addRegexPattern("ampersand", "\\&");
+    runtime.addRegexPattern("minus", "-");
+    runtime.addRegexPattern("parentheses", "[(){}]");
+    runtime.addRegexPattern("colon", ":");
+    runtime.addRegexPattern("statement-separator", ";");
+    runtime.addRegexPattern("statement-separator", ",");
+    runtime.addRegexPattern("identifier", "[A-Za-z_][A-Za-z0-9_-]*");
+    auto compiled = Tokenizer{Tokenization::Tokenizer{}};
+    auto text = std::string{
+        "f(a: Int, b: &Int): Int {\n"
+        "    # a comment, while keywords are left out\n"
+        "    a <= *b => a != 0 (a == 5) { a = a + 1 % 3 - 2 / 1; };\n"
+        "    a >= b > c < d;\n"
+        "}\n"
+    };
+
+    auto expectedText = runtime.tokenize(text);
+    auto& expected = expectedText.tokens;
+    auto actualText = compiled.tokenizer.tokenize(text);
+    auto& actual = actualText.tokens;
+
+    REQUIRE(actual.size() == expected.size());
+    for (int i = 0; i < (int) expected.size(); i++) {
+        REQUIRE(actual.at(i).kind == expected.at(i).kind);
+        REQUIRE(actual.at(i).symbol == expected.at(i).symbol);
+        REQUIRE(actual.at(i).value() == expected.at(i).value());
+    }
+}
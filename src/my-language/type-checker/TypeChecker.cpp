@@ -6,7 +6,7 @@ namespace MyLanguage {
          * Throws a type error that was encountered during type checking.
          */
         void throwTypeError(
-            std::shared_ptr<Expression> expression,
+            Expression* expression,
             std::string message
         ) {
             throw std::runtime_error(
@@ -20,72 +20,62 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckNormalBinaryOperator(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto valueTypes = context->typeStack.pop(2);
-            auto operatorName = expression->subTypes().at("name");
+            auto rightType = context->typeStack.pop();
+            auto leftType = context->typeStack.pop();
+            auto& types = context->types;
 
             if (
-                valueTypes.at(0) != "Any" &&
-                valueTypes.at(1) != "Any" &&
-                valueTypes.at(0) != valueTypes.at(1)
+                leftType != TypeTable::any &&
+                rightType != TypeTable::any &&
+                leftType != rightType
             ) {
                 auto errorMessage = (
-                    std::string("The left value to binary operator '") + operatorName + 
-                    "' was of type '" + valueTypes.at(0) +
-                    "' but the right value was of type '" + valueTypes.at(1) + "'"
+                    std::string("The left value to binary operator '") + expression->subTypes().at("name") + 
+                    "' was of type '" + types.toString(leftType) +
+                    "' but the right value was of type '" + types.toString(rightType) + "'"
                 );
                 throwTypeError(expression, errorMessage);
 
             } else {
-                auto acceptedTypes = std::map<std::string, std::set<std::string>>{
-                    {"and", {"Bool"}},
-                    {"or", {"Bool"}},
-                    {"<", {"Int"}},
-                    {">", {"Int"}},
-                    {"<=", {"Int"}},
-                    {">=", {"Int"}},
-                    {"==", {"Int", "Bool"}},
-                    {"!=", {"Int", "Bool"}},
-                    {"+", {"Int"}},
-                    {"-", {"Int"}},
-                    {"*", {"Int"}},
-                    {"/", {"Int"}},
-                    {"%", {"Int"}}
-                };
-                auto returnedTypes = std::map<std::string, std::string>{
-                    {"and", "Bool"},
-                    {"or", "Bool"},
-                    {"<", "Bool"},
-                    {">", "Bool"},
-                    {"<=", "Bool"},
-                    {">=", "Bool"},
-                    {"==", "Bool"},
-                    {"!=", "Bool"},
-                    {"+", "Int"},
-                    {"-", "Int"},
-                    {"*", "Int"},
-                    {"/", "Int"},
-                    {"%", "Int"}
-                };
-                if (!(acceptedTypes.contains(operatorName))) {
-                    throwTypeError(expression, std::string("'") + operatorName + "' is not a recognized binary operator");
+                auto& operators = *(context->binaryOperatorTypes);
+                auto operatorId = expression->nameId();
+                if (
+                    operatorId < 0 || 
+                    operatorId >= (int) operators.size() || 
+                    operators[operatorId].returnType == TypeTable::none
+                ) {
+                    throwTypeError(
+                        expression, 
+                        std::string("'") + expression->subTypes().at("name") + "' is not a recognized binary operator"
+                    );
                 }
-                auto acceptedTypesForOperator = acceptedTypes.at(operatorName);
-                if (valueTypes.at(0) != "Any" && !(acceptedTypesForOperator.contains(valueTypes.at(0)))) {
+                auto& operatorTypes = operators[operatorId];
+                auto accepts = [&operatorTypes](TypeTable::TTypeId type) {
+                    return (
+                        type == TypeTable::any || 
+                        std::find(
+                            operatorTypes.acceptedTypes.begin(), 
+                            operatorTypes.acceptedTypes.end(), 
+                            type
+                        ) != operatorTypes.acceptedTypes.end()
+                    );
+                };
+                if (!accepts(leftType)) {
                     throwTypeError(
                         expression,
-                        std::string("The left-hand type '") + valueTypes.at(0) + "' to binary operator '" + 
-                        operatorName + "' is an invalid type"
+                        std::string("The left-hand type '") + types.toString(leftType) + "' to binary operator '" + 
+                        expression->subTypes().at("name") + "' is an invalid type"
                     );
-                } else if (valueTypes.at(1) != "Any" && !(acceptedTypesForOperator.contains(valueTypes.at(1)))) {
+                } else if (!accepts(rightType)) {
                     throwTypeError(
                         expression,
-                        std::string("The right-hand type '") + valueTypes.at(1) + "' to binary operator '" + 
-                        operatorName + "' is an invalid type"
+                        std::string("The right-hand type '") + types.toString(rightType) + "' to binary operator '" + 
+                        expression->subTypes().at("name") + "' is an invalid type"
                     );
                 }
-                context->typeStack.stack().push(returnedTypes.at(operatorName));
+                context->typeStack.stack().push(operatorTypes.returnType);
             }
             return context;
         }
@@ -95,34 +85,34 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckVariableDeclaration(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto variableName = expression->subTypes().at("name");
-            auto variableType = expression->subTypes().at("value-type");
+            auto& variableName = expression->subTypes().at("name");
+            auto variableId = expression->nameId();
+            auto variableType = context->types.named(expression->typeId());
             auto rightHandType = context->typeStack.pop();
             
             // If the variable already exists in this scope.
-            if (context->typeSymbolTable.front().contains(variableName)) {
+            if (context->typeSymbolTable.containsInFront(variableId)) {
                 throwTypeError(
                     expression, 
                     std::string("The variable '") + variableName + 
                     "' has already been declared in this scope"
                 );
             }
-            if (variableType != "Any" && variableType != rightHandType) {
+            if (variableType != TypeTable::any && variableType != rightHandType) {
                 throwTypeError(
                     expression,
-                    std::string("Assigning a value of type '") + rightHandType + 
-                    "' to a variable of type '" + variableType + "'"
+                    std::string("Assigning a value of type '") + context->types.toString(rightHandType) + 
+                    "' to a variable of type '" + context->types.toString(variableType) + "'"
                 );
             }
-            context->typeStack.stack().push("Unit");
-            context->typeSymbolTable.insert(variableName, rightHandType);
+            context->typeStack.stack().push(TypeTable::unit);
+            context->typeSymbolTable.insert(variableId, rightHandType);
             // If the right hand expression is a function.
-            if (rightHandType.find("=>") != std::string::npos && rightHandType.back() != '*') {
+            if (context->types.isFunction(rightHandType)) {
                 // Add the variable also as a function to the symbol table of functions.
-                auto functionType = context->functionTypes.at(rightHandType);
-                context->functionTypeSymbolTable.insert(variableName, functionType);
+                context->functionTypeSymbolTable.insert(variableId, rightHandType);
             }
             return context;
         }
@@ -132,7 +122,7 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckAssignment(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto leftHand = expression->children().at(0);
 
@@ -170,12 +160,13 @@ namespace MyLanguage {
             }
 
             // Name of the variable present in the left hand expression.
-            auto variableName = leftHand->subTypes().at("name");
+            auto& variableName = leftHand->subTypes().at("name");
+            auto variableId = leftHand->nameId();
 
             // Next, we want to check that the left hand variable exists in the symbol table.
 
             // If the variable does not exist.
-            if (!(context->typeSymbolTable.contains(variableName))) {
+            if (!(context->typeSymbolTable.contains(variableId))) {
                 throwTypeError(
                     expression, 
                     std::string("Trying to assign to a variable '") + variableName + 
@@ -185,14 +176,20 @@ namespace MyLanguage {
 
             // Now, we want to find the type of the left hand expression.
 
-            auto leftHandType = context->typeSymbolTable.at(variableName);
+            auto leftHandType = context->typeSymbolTable.at(variableId);
 
             // If the left hand expression contains pointer dereferences.
             if (dereferenceLevel != 0) {
                 // The type of the left hand expression is the type of the associated variable minus 
                 // the levels of pointer asterisks accessed.
                 for (int i = 0; i < dereferenceLevel; i++) {
-                    leftHandType.pop_back();
+                    if (!context->types.isPointer(leftHandType)) {
+                        throwTypeError(
+                            expression,
+                            std::string("The variable '") + variableName + "' is dereferenced more times than it has pointer levels"
+                        );
+                    }
+                    leftHandType = context->types.pointee(leftHandType);
                 }
             }
 
@@ -205,8 +202,8 @@ namespace MyLanguage {
             if (leftHandType != valueType) {
                 auto errorMessage = (
                     std::string("The type of the variable '") + variableName + 
-                    "' being assigned to was of type '" + leftHandType +
-                    "' but the value being assigned was of type '" + valueType + "'"
+                    "' being assigned to was of type '" + context->types.toString(leftHandType) +
+                    "' but the value being assigned was of type '" + context->types.toString(valueType) + "'"
                 );
                 throwTypeError(expression, errorMessage);
             }
@@ -219,7 +216,7 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckBinaryOperator(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             if (expression->subTypes().at("name") == "=") {
                 return postCheckAssignment(context, expression);
@@ -233,46 +230,42 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckUnaryOperator(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto& valueType = context->typeStack.stack().top();
-            auto operatorName = expression->subTypes().at("name");
-            auto invalidTypeError = (
-                std::string("The type '") + valueType + 
-                "' is not a valid operand type for the unary operator '" + operatorName + "'"
-            );
+            auto& operatorName = expression->subTypes().at("name");
+            auto throwInvalidTypeError = [context, expression, &valueType, &operatorName]() {
+                throwTypeError(
+                    expression, 
+                    std::string("The type '") + context->types.toString(valueType) + 
+                    "' is not a valid operand type for the unary operator '" + operatorName + "'"
+                );
+            };
             if (operatorName == "new") {
-                if (valueType == "Unit") {
+                if (valueType == TypeTable::unit) {
                     throwTypeError(expression, "Cannot allocate a value of type 'Unit' to the heap.");
                 }
-                valueType = valueType + "*";
+                valueType = context->types.pointerTo(valueType);
             } else if (operatorName == "delete") {
-                if (!(valueType.find("*") != std::string::npos)) {
-                    throwTypeError(expression, invalidTypeError);
+                if (!context->types.isPointer(valueType)) {
+                    throwInvalidTypeError();
                 }
-                valueType = "Unit";
-            } else if ((std::set<std::string>{"not", "-"}).contains(operatorName)) {
-                auto acceptedTypes = std::map<std::string, std::set<std::string>>{
-                    {"not", {"Bool"}},
-                    {"-", {"Int"}}
-                };
-                if (!(acceptedTypes.at(operatorName).contains(valueType))) {
-                    throwTypeError(expression, invalidTypeError);
+                valueType = TypeTable::unit;
+            } else if (operatorName == "not") {
+                if (valueType != TypeTable::boolean) {
+                    throwInvalidTypeError();
                 }
-           } else if (operatorName == "&") {
-                // If the type is a function type, then we want to surround it in parentheses before 
-                // suffixing it with the pointer asterisk.
-                valueType = ((valueType.find("=>") != std::string::npos) && valueType.back() != '*') ? "(" + valueType + ")" : valueType;
-                valueType = valueType + "*";
-            } else if (operatorName == "*") {
-                if (valueType.back() != '*') {
-                    throwTypeError(expression, invalidTypeError);
+            } else if (operatorName == "-") {
+                if (valueType != TypeTable::integer) {
+                    throwInvalidTypeError();
                 }
-                valueType.pop_back();
-                // If the type is surrounded in parentheses we want to strip them.
-                if (valueType.back() == ')') {
-                    valueType = valueType.substr(1, valueType.size() - 2);
+            } else if (operatorName == "&") {
+                valueType = context->types.pointerTo(valueType);
+            } else if (operatorName == "*") {
+                if (!context->types.isPointer(valueType)) {
+                    throwInvalidTypeError();
                 }
+                valueType = context->types.pointee(valueType);
             } else {
                 throwTypeError(expression, std::string("'") + operatorName + "' is not a recognized unary operator");
             }
@@ -284,15 +277,17 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckChain(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             if (expression->children().size() > 0) {
-                auto childTypes = context->typeStack.pop(expression->children().size());
-                std::string lastType = childTypes.back();
+                auto lastType = context->typeStack.stack().top();
+                for (int i = 0; i < (int) expression->children().size(); i++) {
+                    context->typeStack.stack().pop();
+                }
                 if (expression->subTypes().at("openness") == "open") {
-                    context->typeStack.push({lastType});
+                    context->typeStack.stack().push(lastType);
                 } else {
-                    context->typeStack.push({"Unit"});
+                    context->typeStack.stack().push(TypeTable::unit);
                 }
             }
             return context;
@@ -303,24 +298,24 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckIdentifier(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto variableName = expression->subTypes().at("name");
+            auto variableId = expression->nameId();
             if (
-                !(context->typeSymbolTable.contains(variableName)) && 
-                !(context->functionTypeSymbolTable.contains(variableName))
+                !(context->typeSymbolTable.contains(variableId)) && 
+                !(context->functionTypeSymbolTable.contains(variableId))
             ) {
                 throwTypeError(
                     expression, 
-                    std::string("Trying to reference a variable '") + variableName + 
+                    std::string("Trying to reference a variable '") + expression->subTypes().at("name") + 
                     "' that has not been defined"
                 );
             }
 
-            std::string variableType = (
-                context->typeSymbolTable.contains(variableName) ? 
-                context->typeSymbolTable.at(variableName) : 
-                context->functionTypeSymbolTable.at(variableName)->toString()
+            auto variableType = (
+                context->typeSymbolTable.contains(variableId) ? 
+                context->typeSymbolTable.at(variableId) : 
+                context->functionTypeSymbolTable.at(variableId)
             );
             
             context->typeStack.stack().push(variableType);
@@ -332,9 +327,9 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckBoolean(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            context->typeStack.stack().push("Bool");
+            context->typeStack.stack().push(TypeTable::boolean);
             return context;
         }
         
@@ -343,9 +338,9 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckNumber(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            context->typeStack.stack().push("Int");
+            context->typeStack.stack().push(TypeTable::integer);
             return context;
         }
 
@@ -354,7 +349,7 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* preCheckBlock(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             context->typeSymbolTable.pushFront();
             return context;
@@ -365,7 +360,7 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckBlock(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             context->typeSymbolTable.popFront();
             return context;
@@ -376,32 +371,36 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckIf(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             // Types of the portions of the if-statement.
-            auto portionTypes = context->typeStack.pop(expression->children().size());
+            TypeTable::TTypeId portionTypes[3];
+            int portions = expression->children().size();
+            for (int i = portions - 1; i >= 0; i--) {
+                portionTypes[i] = context->typeStack.pop();
+            }
             // If the condition is not a boolean.
-            if (portionTypes.at(0) != "Bool") {
+            if (portionTypes[0] != TypeTable::boolean) {
                 throwTypeError(
                     expression, 
                     std::string("Expected the condition of an if-statement to be of type 'Bool' but instead it was of type '") + 
-                    portionTypes.at(0) + "'"
+                    context->types.toString(portionTypes[0]) + "'"
                 );
             }
             // If the if-statement includes an else-statement.
-            if (expression->children().size() == 3) {
+            if (portions == 3) {
                 // Check that the then-portion and the else-portion have the same type.
-                if (portionTypes.at(1) != portionTypes.at(2)) {
+                if (portionTypes[1] != portionTypes[2]) {
                     throwTypeError(
                         expression,
-                        "The then-portion of if-else statement has type '" + portionTypes.at(1) + 
-                        "' but the else-portion has type '" + portionTypes.at(2) + "'"
+                        "The then-portion of if-else statement has type '" + context->types.toString(portionTypes[1]) + 
+                        "' but the else-portion has type '" + context->types.toString(portionTypes[2]) + "'"
                     );
                 }
                 // The return type is the type of the then-portion and else-portion.
-                context->typeStack.stack().push(portionTypes.at(1));
+                context->typeStack.stack().push(portionTypes[1]);
             } else {
-                context->typeStack.stack().push("Unit");
+                context->typeStack.stack().push(TypeTable::unit);
             }
             return context;
         }
@@ -411,9 +410,9 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* preCheckWhile(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            context->loopBreakTypeStack.stack().push("Any");
+            context->loopBreakTypeStack.stack().push(TypeTable::any);
             return context;
         }
 
@@ -422,10 +421,10 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckWhile(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             auto returnType = context->loopBreakTypeStack.pop();
-            context->typeStack.stack().push(returnType == "Any" ? "Unit" : returnType);
+            context->typeStack.stack().push(returnType == TypeTable::any ? TypeTable::unit : returnType);
             return context;
         }
 
@@ -434,11 +433,11 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckBreak(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto breakResultType = expression->children().size() == 0 ? "Unit" : context->typeStack.pop();
-            std::string& expectedResultType = context->loopBreakTypeStack.stack().top();
-            if (expectedResultType != "Any" && breakResultType != expectedResultType) {
+            auto breakResultType = expression->children().size() == 0 ? TypeTable::unit : context->typeStack.pop();
+            auto& expectedResultType = context->loopBreakTypeStack.stack().top();
+            if (expectedResultType != TypeTable::any && breakResultType != expectedResultType) {
                 throwTypeError(expression, "Breaks in loop have mismatching return types");
             } else {
                 expectedResultType = breakResultType;
@@ -452,9 +451,9 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckContinue(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            context->typeStack.stack().push("Unit");
+            context->typeStack.stack().push(TypeTable::unit);
             return context;
         }
 
@@ -463,49 +462,47 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckFunctionCall(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto functionName = expression->subTypes().at("name");
+            auto& functionName = expression->subTypes().at("name");
             // If the called function is a type constructor.
             if (
-                (std::set<std::string>{"Int", "Bool"}).contains(functionName) || 
+                functionName == "Int" || 
+                functionName == "Bool" || 
                 functionName.find("Int*") != std::string::npos || 
                 functionName.find("Bool*") != std::string::npos
             ) {
                 if (expression->children().size() != 1) {
                     throwTypeError(expression, "Type constructor calls must have exactly one argument");
                 }
+                auto constructedType = context->types.named(expression->nameId());
                 auto argumentType = context->typeStack.pop();
-                if (functionName != argumentType) {
+                if (constructedType != argumentType) {
                     throwTypeError(
                         expression, 
-                        "Type constructor '" + functionName + "' was given an argument of type " + argumentType
+                        "Type constructor '" + functionName + "' was given an argument of type " + 
+                        context->types.toString(argumentType)
                     );
                 }
-                context->typeStack.stack().push(functionName);
-            } else if (!(context->functionTypeSymbolTable.contains(functionName))) {
+                context->typeStack.stack().push(constructedType);
+            } else if (!(context->functionTypeSymbolTable.contains(expression->nameId()))) {
                 throwTypeError(expression, "No function with name '" + functionName + "' found");
             } else {
-                auto functionType = context->functionTypeSymbolTable.at(functionName);
-                auto parameterTypes = context->typeStack.pop(expression->children().size());
-                if (functionType->parameterTypes().size() != parameterTypes.size()) {
+                auto functionType = context->functionTypeSymbolTable.at(expression->nameId());
+                auto& acceptedParameters = context->types.parameterTypes(functionType);
+                int argumentCount = expression->children().size();
+                if ((int) acceptedParameters.size() != argumentCount) {
                     throwTypeError(expression, "Mismatching amount of arguments given to function call");
                 } else {
-                    auto parameterTypesMatch = (std::accumulate(
-                        parameterTypes.begin(),
-                        parameterTypes.end(),
-                        std::pair<int, bool>{0, true}, // Iteration index and the accumulated boolean.
-                        [&functionType](auto acc, auto parameterType) {
-                            auto acceptedParameter = functionType->parameterTypes().at(acc.first);
-                            return std::pair<int, bool>{
-                                acc.first + 1,
-                                acc.second && (
-                                    acceptedParameter->toString() == "Any" || 
-                                    parameterType == acceptedParameter->toString()
-                                )
-                            };
-                        }
-                    )).second;
+                    // The arguments are on the stack with the last one on top.
+                    auto parameterTypesMatch = true;
+                    for (int i = argumentCount - 1; i >= 0; i--) {
+                        auto argumentType = context->typeStack.pop();
+                        parameterTypesMatch = parameterTypesMatch && (
+                            acceptedParameters[i] == TypeTable::any || 
+                            argumentType == acceptedParameters[i]
+                        );
+                    }
                     
                     if (!parameterTypesMatch) {
                         throwTypeError(
@@ -513,7 +510,7 @@ namespace MyLanguage {
                             "Types of given arguments do not match the expected parameters in function call"
                         );
                     } else {
-                        context->typeStack.stack().push(functionType->returnType()->toString());
+                        context->typeStack.stack().push(context->types.returnType(functionType));
                     }
                 }
             }
@@ -525,11 +522,11 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckReturn(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto expectedReturnType = context->functionTypeStack.stack().top()->returnType()->toString();
+            auto expectedReturnType = context->types.returnType(context->functionTypeStack.stack().top());
             auto returnType = context->typeStack.pop();
-            if (expectedReturnType != "Any" && returnType != expectedReturnType) {
+            if (expectedReturnType != TypeTable::any && returnType != expectedReturnType) {
                 throwTypeError(expression, "Type of returned value does not match the expected return type");
             }
             return context;
@@ -540,16 +537,17 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* preCheckFunction(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto returnType = expression->subTypes().at("return-type");
-            auto functionName = expression->subTypes().at("name");
-            auto functionType = context->functionTypeSymbolTable.at(functionName);
-            if (expression->subTypes().at("returns-amount") == "0" && returnType != "Unit") {
+            auto returnType = context->types.named(expression->typeId());
+            auto functionType = context->functionTypeSymbolTable.at(expression->nameId());
+            if (expression->subTypes().at("returns-amount") == "0" && returnType != TypeTable::unit) {
                 throwTypeError(expression, "Missing return statement in function that should return a value");
             }
             context->functionTypeStack.stack().push(functionType);
             context->typeSymbolTable.pushFront();
+            // Variables of function types declared in the body are only visible in it.
+            context->functionTypeSymbolTable.pushFront();
             return context;
         }
 
@@ -558,8 +556,9 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckFunction(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
-        ) {            
+            Expression* expression
+        ) {
+            context->functionTypeSymbolTable.popFront();
             context->typeSymbolTable.popFront();
             context->functionTypeStack.pop();
             return context;
@@ -570,11 +569,10 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckFunctionParameter(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            auto parameterName = expression->subTypes().at("name");
-            auto parameterType = expression->subTypes().at("value-type");
-            context->typeSymbolTable.insert(parameterName, parameterType);
+            auto parameterType = context->types.named(expression->typeId());
+            context->typeSymbolTable.insert(expression->nameId(), parameterType);
             return context;
         }
 
@@ -583,32 +581,27 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* preCheckModule(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             context->functionTypeSymbolTable.pushFront();
             context->typeSymbolTable.pushFront();
 
             std::for_each(expression->children().begin(), expression->children().end(), [context](auto child) {
                 if (child->type() == "function") {
-                    auto functionName = child->subTypes().at("name");
                     auto parameters = child->children().at(0)->children();
-                    auto returnType = child->subTypes().at("return-type");
 
-                    auto parameterTypes = std::vector<std::shared_ptr<IType>>{};
+                    auto parameterTypes = std::vector<TypeTable::TTypeId>{};
                     std::transform(
                         parameters.begin(),
                         parameters.end(),
                         std::back_inserter(parameterTypes),
-                        [](auto parameter) {
-                            return std::shared_ptr<IType>(new Type{parameter->subTypes().at("value-type")});
+                        [context](auto parameter) {
+                            return context->types.named(parameter->typeId());
                         }
                     );
 
-                    auto functionType = std::shared_ptr<FunctionType>(
-                        new FunctionType{parameterTypes, std::shared_ptr<IType>(new Type{returnType})}
-                    );
-                    context->functionTypeSymbolTable.insert(functionName, functionType);
-                    context->functionTypes.insert({functionType->toString(), functionType});
+                    auto functionType = context->types.function(parameterTypes, context->types.named(child->typeId()));
+                    context->functionTypeSymbolTable.insert(child->nameId(), functionType);
                 }
             });
 
@@ -620,7 +613,7 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckModule(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
             context->functionTypeSymbolTable.popFront();
             context->typeSymbolTable.popFront();
@@ -632,14 +625,29 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* postCheckAny(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            if (context->postTypeCheckers->contains(expression->type())) {
-                // Choose the corresponding type checker function.
-                auto generate = context->postTypeCheckers->at(expression->type());
-                return generate(context, expression);
-            } else {
-                return context;
+            // Choose the corresponding type checker function.
+            switch (NodeKinds::of(expression)) {
+                case ENodeKind::number: return postCheckNumber(context, expression);
+                case ENodeKind::boolean: return postCheckBoolean(context, expression);
+                case ENodeKind::chain: return postCheckChain(context, expression);
+                case ENodeKind::binaryOperator: return postCheckBinaryOperator(context, expression);
+                case ENodeKind::unaryOperator: return postCheckUnaryOperator(context, expression);
+                case ENodeKind::functionCall: return postCheckFunctionCall(context, expression);
+                case ENodeKind::variableDeclaration: return postCheckVariableDeclaration(context, expression);
+                case ENodeKind::identifier: return postCheckIdentifier(context, expression);
+                case ENodeKind::block: return postCheckBlock(context, expression);
+                case ENodeKind::ifExpression: return postCheckIf(context, expression);
+                case ENodeKind::whileExpression: return postCheckWhile(context, expression);
+                case ENodeKind::function: return postCheckFunction(context, expression);
+                case ENodeKind::functionParameter: return postCheckFunctionParameter(context, expression);
+                case ENodeKind::returnExpression: return postCheckReturn(context, expression);
+                case ENodeKind::assignment: return postCheckAssignment(context, expression);
+                case ENodeKind::module: return postCheckModule(context, expression);
+                case ENodeKind::breakExpression: return postCheckBreak(context, expression);
+                case ENodeKind::continueExpression: return postCheckContinue(context, expression);
+                default: return context;
             }
         }
 
@@ -648,91 +656,95 @@ namespace MyLanguage {
          */
         TypeChecker::DTypeCheckContext* preCheckAny(
             TypeChecker::DTypeCheckContext* context,
-            std::shared_ptr<Expression> expression
+            Expression* expression
         ) {
-            if (context->preTypeCheckers->contains(expression->type())) {
-                // Choose the corresponding type checker function.
-                auto generate = context->preTypeCheckers->at(expression->type());
-                return generate(context, expression);
-            } else {
-                return context;
+            // Choose the corresponding type checker function.
+            switch (NodeKinds::of(expression)) {
+                case ENodeKind::block: return preCheckBlock(context, expression);
+                case ENodeKind::function: return preCheckFunction(context, expression);
+                case ENodeKind::module: return preCheckModule(context, expression);
+                case ENodeKind::whileExpression: return preCheckWhile(context, expression);
+                default: return context;
             }
         }
     }
     
     TypeChecker::TypeChecker()
     {
-        this->_preTypeCheckers = {
-            {"block", TypeCheckers::preCheckBlock},
-            {"function", TypeCheckers::preCheckFunction},
-            {"module", TypeCheckers::preCheckModule},
-            {"while", TypeCheckers::preCheckWhile}
-        };
-
-        this->_postTypeCheckers = {
-            {"number", TypeCheckers::postCheckNumber},
-            {"boolean", TypeCheckers::postCheckBoolean},
-            {"chain", TypeCheckers::postCheckChain},
-            {"binary-operator", TypeCheckers::postCheckBinaryOperator},
-            {"unary-operator", TypeCheckers::postCheckUnaryOperator},
-            {"function-call", TypeCheckers::postCheckFunctionCall},
-            {"variable-declaration", TypeCheckers::postCheckVariableDeclaration},
-            {"identifier", TypeCheckers::postCheckIdentifier},
-            {"block", TypeCheckers::postCheckBlock},
-            {"if", TypeCheckers::postCheckIf},
-            {"while", TypeCheckers::postCheckWhile},
-            {"function", TypeCheckers::postCheckFunction},
-            {"function-parameter", TypeCheckers::postCheckFunctionParameter},
-            {"return", TypeCheckers::postCheckReturn},
-            {"assignment", TypeCheckers::postCheckAssignment},
-            {"module", TypeCheckers::postCheckModule},
-            {"break", TypeCheckers::postCheckBreak},
-            {"continue", TypeCheckers::postCheckContinue}
+        auto binaryOperatorTypes = std::map<std::string, DOperatorTypes>{
+            {"and", {{TypeTable::boolean}, TypeTable::boolean}},
+            {"or", {{TypeTable::boolean}, TypeTable::boolean}},
+            {"<", {{TypeTable::integer}, TypeTable::boolean}},
+            {">", {{TypeTable::integer}, TypeTable::boolean}},
+            {"<=", {{TypeTable::integer}, TypeTable::boolean}},
+            {">=", {{TypeTable::integer}, TypeTable::boolean}},
+            {"==", {{TypeTable::integer, TypeTable::boolean}, TypeTable::boolean}},
+            {"!=", {{TypeTable::integer, TypeTable::boolean}, TypeTable::boolean}},
+            {"+", {{TypeTable::integer}, TypeTable::integer}},
+            {"-", {{TypeTable::integer}, TypeTable::integer}},
+            {"*", {{TypeTable::integer}, TypeTable::integer}},
+            {"/", {{TypeTable::integer}, TypeTable::integer}},
+            {"%", {{TypeTable::integer}, TypeTable::integer}}
         };
+        for (auto& [name, operatorTypes] : binaryOperatorTypes) {
+            auto id = Parsing::Names::id(name);
+            if (id >= (int) this->_binaryOperatorTypes.size()) {
+                this->_binaryOperatorTypes.resize(id + 1);
+            }
+            this->_binaryOperatorTypes[id] = operatorTypes;
+        }
     }
 
     void TypeChecker::check(TExpression root)
     {
-        auto context = TypeChecker::DTypeCheckContext{&(this->_preTypeCheckers), &(this->_postTypeCheckers)};
-
-        // Temporary solution for getting a proper function type object from a function type signature string.
-        context.functionTypes = std::map<std::string, std::shared_ptr<FunctionType>>{
-            {
-                "(Int) => Unit",
-                std::shared_ptr<FunctionType>(
-                new FunctionType{
-                        {std::shared_ptr<IType>(new Type{"Int"})},
-                        std::shared_ptr<IType>(new Type{"Unit"})
-                    }
-                )
-            },
-            {
-                "(Bool) => Unit",
-                std::shared_ptr<FunctionType>(
-                    new FunctionType{
-                        {std::shared_ptr<IType>(new Type{"Bool"})}, 
-                        std::shared_ptr<IType>(new Type{"Unit"})
-                    }
-                )
-            },
-            {
-                "() => Int",
-                std::shared_ptr<FunctionType>(
-                new FunctionType{
-                        {},
-                        std::shared_ptr<IType>(new Type{"Int"})
-                    }
-                )
-            }
-        };
+        auto context = TypeChecker::DTypeCheckContext{&(this->_binaryOperatorTypes)};
 
         // Set types of global built-in functions.
-        context.functionTypeSymbolTable.insert("print_int", context.functionTypes.at("(Int) => Unit"));
-        context.functionTypeSymbolTable.insert("print_bool", context.functionTypes.at("(Bool) => Unit"));
-        context.functionTypeSymbolTable.insert("read_int", context.functionTypes.at("() => Int"));
+        auto& types = context.types;
+        context.functionTypeSymbolTable.insert(Parsing::Names::id("print_int"), types.function({TypeTable::integer}, TypeTable::unit));
+        context.functionTypeSymbolTable.insert(Parsing::Names::id("print_bool"), types.function({TypeTable::boolean}, TypeTable::unit));
+        context.functionTypeSymbolTable.insert(Parsing::Names::id("read_int"), types.function({}, TypeTable::integer));
+
+        if (this->_threadPool != nullptr && NodeKinds::of(root) == ENodeKind::module) {
+            this->_checkFunctionsConcurrently(root, context);
+        } else {
+            DataStructures::foldTree<TypeCheckers::postCheckAny, TypeCheckers::preCheckAny>(root, &context);
+        }
+    }
+
+    void TypeChecker::setThreads(int threads)
+    {
+        if (threads > 1) {
+            this->_threadPool = std::unique_ptr<Concurrency::ThreadPool>(new Concurrency::ThreadPool{threads});
+        } else {
+            this->_threadPool = nullptr;
+        }
+    }
+
+    void TypeChecker::_checkFunctionsConcurrently(TExpression module, DTypeCheckContext& context)
+    {
+        // The pre-pass of the module binds the signatures of all functions, after which the 
+        // module scope is only read. Each thread checks function bodies on a copy of it.
+        TypeCheckers::preCheckModule(&context, module);
+        auto functions = module->children();
+        auto threadContexts = std::vector<DTypeCheckContext>(this->_threadPool->threads(), context);
+        auto errors = std::vector<std::exception_ptr>(functions.size());
+        this->_threadPool->forEach((int) functions.size(), [&](int index, int thread) {
+            try {
+                DataStructures::foldTree<TypeCheckers::postCheckAny, TypeCheckers::preCheckAny>(functions[index], &threadContexts[thread]);
+            } catch (std::exception&) {
+                errors[index] = std::current_exception();
+                // The scopes of the failed function were left open, so start over from the module scope.
+                threadContexts[thread] = context;
+            }
+        });
 
-        auto foldable = DataStructures::FoldableNode<TypeChecker::DTypeCheckContext*, TypeChecker::TExpression>{root};
-        foldable.setPreFolder(TypeCheckers::preCheckAny);
-        foldable.fold(TypeCheckers::postCheckAny, &context);
+        // Report the error of the first function in the source, as checking one by one would.
+        for (auto& error : errors) {
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+        }
+        TypeCheckers::postCheckModule(&context, module);
     }
 }
\ No newline at end of file
@@ -1,14 +1,15 @@
 #ifndef MY_LANGUAGE_TYPE_CHECKER_HH
 #define MY_LANGUAGE_TYPE_CHECKER_HH
 
-#include "../../components/data_structures/FoldableNode.h"
+#include "../../components/data_structures/TreeFold.h"
 #include "../../components/data_structures/BatchStack.h"
-#include "../../components/data_structures/LinkedMap.h"
+#include "../../components/data_structures/ScopedSymbolTable.h"
+#include "../../components/concurrency/ThreadPool.h"
 #include "../../components/parsing/Expression.h"
-#include "FunctionType.h"
-#include "Type.h"
-#include "IType.h"
+#include "../parser/NodeKinds.h"
+#include "TypeTable.h"
 #include <map>
+#include <memory>
 #include <algorithm>
 #include <set>
 #include <stack>
@@ -20,29 +21,30 @@ namespace MyLanguage {
      */
     class TypeChecker {
         public:
-            using TExpression = std::shared_ptr<Expression>;
-            struct DTypeCheckContext;
-
-            using TTypeChecker = std::function<
-                DTypeCheckContext*(
-                    DTypeCheckContext*,
-                    TExpression
-                )
-            >;
+            using TExpression = Expression*;
+            /**
+             * The types accepted and returned by a binary operator.
+             */
+            struct DOperatorTypes {
+                std::vector<TypeTable::TTypeId> acceptedTypes {};
+                TypeTable::TTypeId returnType {TypeTable::none};
+            };
 
             /**
              * Type of the context object being passed around when type checking 
              *  the abstract syntax tree by folding over it.
              */
             struct DTypeCheckContext {
-                std::map<std::string, TTypeChecker>* preTypeCheckers {nullptr};
-                std::map<std::string, TTypeChecker>* postTypeCheckers {nullptr};
-                DataStructures::BatchStack<std::string> typeStack {};
-                DataStructures::LinkedMap<std::string> typeSymbolTable {};
-                DataStructures::LinkedMap<std::shared_ptr<FunctionType>> functionTypeSymbolTable {};
-                DataStructures::BatchStack<std::string> loopBreakTypeStack {};
-                DataStructures::BatchStack<std::shared_ptr<FunctionType>> functionTypeStack {};
-                std::map<std::string, std::shared_ptr<FunctionType>> functionTypes;
+                /**
+                 * Binary operators by the interned ids of their names.
+                 */
+                std::vector<DOperatorTypes>* binaryOperatorTypes {nullptr};
+                TypeTable types {};
+                DataStructures::BatchStack<TypeTable::TTypeId> typeStack {};
+                DataStructures::ScopedSymbolTable<TypeTable::TTypeId> typeSymbolTable {};
+                DataStructures::ScopedSymbolTable<TypeTable::TTypeId> functionTypeSymbolTable {};
+                DataStructures::BatchStack<TypeTable::TTypeId> loopBreakTypeStack {};
+                DataStructures::BatchStack<TypeTable::TTypeId> functionTypeStack {};
             };
 
             TypeChecker();
@@ -50,9 +52,16 @@ namespace MyLanguage {
              * Perform type checking on the given parse tree.
              */
             void check(TExpression root);
+            /**
+             * Sets the amount of threads checking the functions of a module side by side 
+             * once their signatures are known. Errors are the same whatever the amount: 
+             * the one reported is that of the first function in the source. One by default.
+             */
+            void setThreads(int threads);
         private:
-            std::map<std::string, TTypeChecker> _preTypeCheckers;
-            std::map<std::string, TTypeChecker> _postTypeCheckers;
+            std::vector<DOperatorTypes> _binaryOperatorTypes;
+            std::unique_ptr<Concurrency::ThreadPool> _threadPool;
+            void _checkFunctionsConcurrently(TExpression module, DTypeCheckContext& context);
     };
 };
 
@@ -0,0 +1,163 @@
+#include "TypeTable.h"
+#include <stdexcept>
+#include "../../components/parsing/Names.h"
+
+namespace MyLanguage {
+    TypeTable::TypeTable()
+    {
+        // The order matches the ids of the primitive types.
+        for (auto name : {"Unit", "Int", "Bool", "Any"}) {
+            this->primitive(name);
+        }
+    }
+
+    TypeTable::TTypeId TypeTable::primitive(std::string_view name)
+    {
+        auto key = std::string{name};
+        auto existing = this->_primitives.find(key);
+        if (existing != this->_primitives.end()) {
+            return existing->second;
+        }
+        auto type = this->_add(DType{EKind::primitive, key});
+        this->_primitives.insert({key, type});
+        return type;
+    }
+
+    TypeTable::TTypeId TypeTable::pointerTo(TTypeId type)
+    {
+        if (this->_types.at(type).pointer == none) {
+            auto pointer = this->_add(DType{EKind::pointer, "", type});
+            this->_types.at(type).pointer = pointer;
+        }
+        return this->_types.at(type).pointer;
+    }
+
+    TypeTable::TTypeId TypeTable::function(const std::vector<TTypeId>& parameterTypes, TTypeId returnType)
+    {
+        auto key = parameterTypes;
+        key.push_back(returnType);
+        auto existing = this->_functions.find(key);
+        if (existing != this->_functions.end()) {
+            return existing->second;
+        }
+        auto type = this->_add(DType{EKind::function, "", none, none, parameterTypes, returnType});
+        this->_functions.insert({key, type});
+        return type;
+    }
+
+    TypeTable::TTypeId TypeTable::named(int nameId)
+    {
+        if (nameId == Parsing::Names::none) {
+            throw std::out_of_range("No type name was given.");
+        }
+        if (nameId >= (int) this->_namedTypes.size()) {
+            this->_namedTypes.resize(nameId + 1, none);
+        }
+        if (this->_namedTypes[nameId] == none) {
+            this->_namedTypes[nameId] = this->parse(Parsing::Names::name(nameId));
+        }
+        return this->_namedTypes[nameId];
+    }
+
+    TypeTable::TTypeId TypeTable::parse(std::string_view text)
+    {
+        std::size_t position = 0;
+        auto type = this->_parse(text, position);
+        if (position != text.size()) {
+            throw std::runtime_error("Unexpected text after the type in '" + std::string{text} + "'.");
+        }
+        return type;
+    }
+
+    bool TypeTable::isPointer(TTypeId type)
+    {
+        return this->_types.at(type).kind == EKind::pointer;
+    }
+
+    bool TypeTable::isFunction(TTypeId type)
+    {
+        return this->_types.at(type).kind == EKind::function;
+    }
+
+    TypeTable::TTypeId TypeTable::pointee(TTypeId type)
+    {
+        return this->_types.at(type).pointee;
+    }
+
+    const std::vector<TypeTable::TTypeId>& TypeTable::parameterTypes(TTypeId functionType)
+    {
+        return this->_types.at(functionType).parameterTypes;
+    }
+
+    TypeTable::TTypeId TypeTable::returnType(TTypeId functionType)
+    {
+        return this->_types.at(functionType).returnType;
+    }
+
+    std::string TypeTable::toString(TTypeId type)
+    {
+        auto& entry = this->_types.at(type);
+        if (entry.kind == EKind::primitive) {
+            return entry.name;
+        } else if (entry.kind == EKind::pointer) {
+            // Function types are surrounded in parentheses so that the asterisk
+            // does not read as a part of the return type.
+            auto pointee = this->toString(entry.pointee);
+            return (this->isFunction(entry.pointee) ? "(" + pointee + ")" : pointee) + "*";
+        } else {
+            std::string result = "(";
+            for (std::size_t i = 0; i < entry.parameterTypes.size(); i++) {
+                result += (i == 0 ? "" : ", ") + this->toString(entry.parameterTypes[i]);
+            }
+            return result + ") => " + this->toString(entry.returnType);
+        }
+    }
+
+    TypeTable::TTypeId TypeTable::_add(DType type)
+    {
+        this->_types.push_back(type);
+        return (TTypeId) this->_types.size() - 1;
+    }
+
+    TypeTable::TTypeId TypeTable::_parse(std::string_view text, std::size_t& position)
+    {
+        auto type = none;
+        if (position < text.size() && text[position] == '(') {
+            // Either a parameter list followed by '=>' or a type in parentheses.
+            position++;
+            auto types = std::vector<TTypeId>{};
+            while (position < text.size() && text[position] != ')') {
+                types.push_back(this->_parse(text, position));
+                if (text.substr(position, 2) == ", ") {
+                    position += 2;
+                }
+            }
+            if (position == text.size()) {
+                throw std::runtime_error("Missing ')' in the type '" + std::string{text} + "'.");
+            }
+            position++;
+            if (text.substr(position, 4) == " => ") {
+                position += 4;
+                auto returnType = this->_parse(text, position);
+                type = this->function(types, returnType);
+            } else if (types.size() == 1) {
+                type = types.at(0);
+            } else {
+                throw std::runtime_error("Expected '=>' after the parameter types in '" + std::string{text} + "'.");
+            }
+        } else {
+            auto end = text.find_first_of("*), ", position);
+            end = end == std::string_view::npos ? text.size() : end;
+            if (end == position) {
+                throw std::runtime_error("Expected a type name in '" + std::string{text} + "'.");
+            }
+            type = this->primitive(text.substr(position, end - position));
+            position = end;
+        }
+        while (position < text.size() && text[position] == '*') {
+            type = this->pointerTo(type);
+            position++;
+        }
+        return type;
+    }
+}
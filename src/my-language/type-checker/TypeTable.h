@@ -0,0 +1,90 @@
+#ifndef MY_LANGUAGE_TYPE_CHECKER_TYPE_TABLE_HH
+#define MY_LANGUAGE_TYPE_CHECKER_TYPE_TABLE_HH
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MyLanguage {
+    /**
+     * Gives every distinct type of the language one integer id. A type is either a
+     * primitive type such as Int, a pointer to a type, or a function type. Types are
+     * hash-consed: building the same type twice gives the same id, so types are equal
+     * exactly when their ids are. Pointer types and their targets know each other,
+     * so taking a pointer to a type or dereferencing one is a lookup by index.
+     */
+    class TypeTable {
+        public:
+            using TTypeId = int;
+            /**
+             * The id of no type at all.
+             */
+            static constexpr TTypeId none = -1;
+            // The primitive types, which every table starts with.
+            static constexpr TTypeId unit = 0;
+            static constexpr TTypeId integer = 1;
+            static constexpr TTypeId boolean = 2;
+            static constexpr TTypeId any = 3;
+            TypeTable();
+            /**
+             * Returns the primitive type with the given name.
+             */
+            TTypeId primitive(std::string_view name);
+            /**
+             * Returns the type of pointers to the given type.
+             */
+            TTypeId pointerTo(TTypeId type);
+            /**
+             * Returns the function type with the given parameter types and return type.
+             */
+            TTypeId function(const std::vector<TTypeId>& parameterTypes, TTypeId returnType);
+            /**
+             * Returns the type written in the source with the given name, such as
+             * "Int*" or "((Int, Bool) => Unit)*". The name is given as the id it
+             * was interned with in Parsing::Names, and the type of each name is
+             * remembered so that later lookups are an index into a vector.
+             */
+            TTypeId named(int nameId);
+            /**
+             * Returns the type written in the source as the given text.
+             */
+            TTypeId parse(std::string_view text);
+            bool isPointer(TTypeId type);
+            bool isFunction(TTypeId type);
+            /**
+             * Returns the type that the given pointer type points to, or none if the
+             * type is not a pointer.
+             */
+            TTypeId pointee(TTypeId type);
+            const std::vector<TTypeId>& parameterTypes(TTypeId functionType);
+            TTypeId returnType(TTypeId functionType);
+            /**
+             * Returns the type as it would be written in the source.
+             */
+            std::string toString(TTypeId type);
+        private:
+            enum class EKind {primitive, pointer, function};
+            struct DType {
+                EKind kind;
+                std::string name;
+                // The type pointed to by a pointer type.
+                TTypeId pointee {none};
+                // The type of pointers to this type, once created.
+                TTypeId pointer {none};
+                std::vector<TTypeId> parameterTypes {};
+                TTypeId returnType {none};
+            };
+            TTypeId _add(DType type);
+            TTypeId _parse(std::string_view text, std::size_t& position);
+            std::vector<DType> _types;
+            std::unordered_map<std::string, TTypeId> _primitives;
+            // Function types by their parameter types followed by their return type.
+            std::map<std::vector<TTypeId>, TTypeId> _functions;
+            // The types of source type names by the ids of the names.
+            std::vector<TTypeId> _namedTypes;
+    };
+};
+
+#endif
@@ -0,0 +1,107 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../../../libraries/doctest.h"
+#include "../TypeChecker.h"
+#include "../../parser/Parser.h"
+#include "../../tokenizer/Tokenizer.h"
+#include <map>
+
+namespace Test {
+    // The expressions of all tests live as long as the test program.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
+    auto parser = MyLanguage::Parser{};
+    auto tokenizer = Tokenizer{};
+
+    // The amounts of threads that checks are compared across.
+    const int threadAmounts[] = {2, 3, 8};
+
+    /**
+     * A module of the given amount of functions followed by a call of the last one.
+     * The bodies of the functions at the given indices get the given statements too.
+     */
+    std::string createModule(int functions, std::map<int, std::string> statements) {
+        auto text = std::string{};
+        for (int i = 0; i < functions; i++) {
+            text += "fun f" + std::to_string(i) + "(x: Int): Int {\n";
+            text += "    var y = x + " + std::to_string(i) + ";\n";
+            if (statements.contains(i)) {
+                text += "    " + statements[i] + "\n";
+            }
+            text += "    return y;\n";
+            text += "}\n";
+        }
+        return text + "print_int(f" + std::to_string(functions - 1) + "(1));\n";
+    }
+
+    /**
+     * Type checks the module with the given amount of threads, returning the error
+     * reported, or an empty string if there is none.
+     */
+    std::string check(const std::string& text, int threads) {
+        auto tokenized = Test::tokenizer.tokenizer.tokenize(text);
+        auto root = Test::parser.parse(tokenized.tokens, 0);
+        auto typeChecker = MyLanguage::TypeChecker{};
+        typeChecker.setThreads(threads);
+        try {
+            typeChecker.check(root);
+        } catch (std::runtime_error& error) {
+            return error.what();
+        }
+        return "";
+    }
+}
+
+TEST_CASE("Valid modules pass on any amount of threads") {
+    auto module = Test::createModule(64, {{10, "print_int(f9(y));"}, {40, "var g = f3; print_int(g(y));"}});
+    REQUIRE(Test::check(module, 1) == "");
+    for (int threads : Test::threadAmounts) {
+        REQUIRE(Test::check(module, threads) == "");
+    }
+}
+
+TEST_CASE("The first error in the source is reported on any amount of threads") {
+    auto errors = std::map<int, std::string>{
+        {5, "var z: Bool = y;"},
+        {20, "print_int(true);"},
+        {41, "unknown(y);"},
+        {63, "var w: Int = true;"}
+    };
+    // The error of the first erroneous function is the one reported when it is the only one.
+    auto expected = Test::check(Test::createModule(64, {*errors.begin()}), 1);
+    REQUIRE(expected != "");
+    REQUIRE(Test::check(Test::createModule(64, errors), 1) == expected);
+    for (int threads : Test::threadAmounts) {
+        REQUIRE(Test::check(Test::createModule(64, errors), threads) == expected);
+    }
+
+    // Checking goes on past functions that fail on the same thread.
+    errors.erase(5);
+    auto later = Test::check(Test::createModule(64, {*errors.begin()}), 1);
+    REQUIRE(later != expected);
+    for (int threads : Test::threadAmounts) {
+        REQUIRE(Test::check(Test::createModule(64, errors), threads) == later);
+    }
+}
+
+TEST_CASE("Variables of function types are only visible in the body declaring them") {
+    // Every even function declares and calls a variable of a function type.
+    auto statements = std::map<int, std::string>{};
+    for (int i = 0; i < 64; i += 2) {
+        statements[i] = "var show = print_int; show(y);";
+    }
+    auto valid = Test::createModule(64, statements);
+    REQUIRE(Test::check(valid, 1) == "");
+    for (int threads : Test::threadAmounts) {
+        REQUIRE(Test::check(valid, threads) == "");
+    }
+
+    // An odd function calling it does not see it, even when checked after an even one on the same thread.
+    statements[33] = "show(y);";
+    auto invalid = Test::createModule(64, statements);
+    auto expected = Test::check(invalid, 1);
+    REQUIRE(expected.find("No function with name 'show' found") != std::string::npos);
+    for (int threads : Test::threadAmounts) {
+        REQUIRE(Test::check(invalid, threads) == expected);
+    }
+}
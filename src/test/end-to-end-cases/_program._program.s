@@ -0,0 +1,78 @@
+    .extern print_int
+    .extern print_bool
+    .extern read_int
+    .extern malloc
+    .extern free
+    .global main
+    
+    .section .text
+    
+    # FunctionLabel
+main:
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $128, %rsp
+    # LoadIntConst
+    movq $2, -8(%rbp)
+    # Copy
+    movq -8(%rbp), %rax
+    movq %rax, -72(%rbp)
+    # Call
+    movq %rbp, %rax
+    addq $-72, %rax
+    movq %rax, -80(%rbp)
+    # Copy
+    movq -80(%rbp), %rax
+    movq %rax, -88(%rbp)
+    # Call
+    movq %rbp, %rax
+    addq $-88, %rax
+    movq %rax, -96(%rbp)
+    # Copy
+    movq -96(%rbp), %rax
+    movq %rax, -104(%rbp)
+    # Call
+    movq -104(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -112(%rbp)
+    # Call
+    movq -112(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -120(%rbp)
+    # Call
+    movq -120(%rbp), %rdi
+    call print_int
+    movq %rax, -128(%rbp)
+    # Call
+    movq -104(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -16(%rbp)
+    # Call
+    movq -16(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -24(%rbp)
+    # LoadIntConst
+    movq $3, -32(%rbp)
+    # CopyToAddressOf
+    movq -32(%rbp), %rax
+    movq -16(%rbp), %rbx
+    movq %rax, (%rbx)
+    # Call
+    movq -104(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -40(%rbp)
+    # Call
+    movq -40(%rbp), %rax
+    movq (%rax), %rax
+    movq %rax, -48(%rbp)
+    # Call
+    movq -48(%rbp), %rdi
+    call print_int
+    movq %rax, -56(%rbp)
+    # LoadIntConst
+    movq $0, -64(%rbp)
+    # WriteFunctionReturn
+    movq -64(%rbp), %rax
+    movq %rbp, %rsp
+    popq %rbp
+    ret
@@ -6,6 +6,9 @@
 #include <iostream>
 
 namespace Test {
+    // The expressions live as long as the program.
+    auto arena = Parsing::ExpressionArena{};
+    auto arenaScope = Parsing::ExpressionArena::Scope{arena};
     auto parser = MyLanguage::Parser{};
     auto tokenizer = Tokenizer{};
     auto irGenerator = MyLanguage::ModuleIRGenerator{};
@@ -30,7 +33,8 @@ f(ap, bpp);\
 print_int(*ap);\
 print_int(**bpp);"; */
     auto input = "var a = new Int(10); delete a;";
-    auto tokens = Test::tokenizer.tokenizer.tokenize(input);
+    auto tokenized = Test::tokenizer.tokenizer.tokenize(input);
+    auto& tokens = tokenized.tokens;
     auto root = Test::parser.parse(tokens, 0);
     Test::typeChecker.check(root);
     auto irCommands = Test::irGenerator.generate(root);